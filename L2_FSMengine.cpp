@@ -0,0 +1,160 @@
+#include "mbed.h"
+#include "L2_FSMengine.h"
+#include "protocol_parameters.h"
+
+//dispatch table (built at compile time by the FSM owner)
+static const L2_FSMstate_t* fsmTable = NULL;
+static uint8_t fsmNbStates = 0;
+
+//events that have a transition, per state (derived once from the table)
+static uint32_t stateMask[L2_FSMENGINE_MAXSTATE];
+
+//per-transition statistics
+static uint32_t nbDispatch = 0;
+static uint32_t transitionCnt[L2_FSMENGINE_MAXSTATE][L2_EVENT_NB];
+#if L2_FSM_PROFILING
+static uint32_t latencySum[L2_FSMENGINE_MAXSTATE][L2_EVENT_NB];   //us
+static uint32_t latencyMax[L2_FSMENGINE_MAXSTATE][L2_EVENT_NB];   //us
+#endif
+
+
+void L2_FSMengine_init(const L2_FSMstate_t* table, uint8_t nbStates)
+{
+    if (nbStates > L2_FSMENGINE_MAXSTATE)
+    {
+        debug("[L2][WARNING] FSM table has too many states (%i), truncating to %i\n", nbStates, L2_FSMENGINE_MAXSTATE);
+        nbStates = L2_FSMENGINE_MAXSTATE;
+    }
+
+    fsmTable = table;
+    fsmNbStates = nbStates;
+
+    for (uint8_t s=0;s<L2_FSMENGINE_MAXSTATE;s++)
+    {
+        stateMask[s] = 0;
+        if (s >= nbStates)
+            continue;
+
+        for (uint8_t i=0;i<table[s].nbTransitions;i++)
+            stateMask[s] |= (0x01 << table[s].transitions[i].event);
+    }
+
+    L2_FSMengine_resetStats();
+}
+
+
+//runs at most one transition for the current state and returns the next state
+uint8_t L2_FSMengine_dispatch(uint8_t state)
+{
+    if (state >= fsmNbStates)
+        return state;
+
+    //single test for the idle case : nothing pending that this state handles
+    uint32_t pending = L2_event_getEventFlags() & stateMask[state];
+    if (pending == 0)
+        return state;
+
+    const L2_FSMstate_t* row = &fsmTable[state];
+    for (uint8_t i=0;i<row->nbTransitions;i++)
+    {
+        L2_event_e event = row->transitions[i].event;
+        if ((pending & (0x01 << event)) == 0)
+            continue;
+
+        L2_event_clearEventFlag(event);
+
+#if L2_FSM_PROFILING
+        uint32_t startTime = us_ticker_read();
+#endif
+        uint8_t nextState = row->transitions[i].handler(state, event);
+#if L2_FSM_PROFILING
+        uint32_t latency = us_ticker_read() - startTime;
+
+        latencySum[state][event] += latency;
+        if (latency > latencyMax[state][event])
+            latencyMax[state][event] = latency;
+#endif
+        transitionCnt[state][event]++;
+        nbDispatch++;
+
+#if L2_FSM_STATPERIOD > 0
+        if (nbDispatch % L2_FSM_STATPERIOD == 0)
+            L2_FSMengine_printStats();
+#endif
+
+        return nextState;
+    }
+
+    return state;
+}
+
+
+//statistics ----------------------------------------------
+uint32_t L2_FSMengine_getCount(uint8_t state, L2_event_e event)
+{
+    if (state >= L2_FSMENGINE_MAXSTATE || event >= L2_EVENT_NB)
+        return 0;
+
+    return transitionCnt[state][event];
+}
+
+uint32_t L2_FSMengine_getMaxLatency(uint8_t state, L2_event_e event)
+{
+#if L2_FSM_PROFILING
+    if (state >= L2_FSMENGINE_MAXSTATE || event >= L2_EVENT_NB)
+        return 0;
+
+    return latencyMax[state][event];
+#else
+    return 0;
+#endif
+}
+
+uint32_t L2_FSMengine_getAvgLatency(uint8_t state, L2_event_e event)
+{
+#if L2_FSM_PROFILING
+    if (state >= L2_FSMENGINE_MAXSTATE || event >= L2_EVENT_NB || transitionCnt[state][event] == 0)
+        return 0;
+
+    return latencySum[state][event]/transitionCnt[state][event];
+#else
+    return 0;
+#endif
+}
+
+uint32_t L2_FSMengine_getNbDispatch(void)
+{
+    return nbDispatch;
+}
+
+void L2_FSMengine_resetStats(void)
+{
+    nbDispatch = 0;
+    for (uint8_t s=0;s<L2_FSMENGINE_MAXSTATE;s++)
+    {
+        for (uint8_t e=0;e<L2_EVENT_NB;e++)
+        {
+            transitionCnt[s][e] = 0;
+#if L2_FSM_PROFILING
+            latencySum[s][e] = 0;
+            latencyMax[s][e] = 0;
+#endif
+        }
+    }
+}
+
+void L2_FSMengine_printStats(void)
+{
+    debug("\n[L2] FSM transition stats (%i dispatches)\n", nbDispatch);
+    for (uint8_t s=0;s<fsmNbStates;s++)
+    {
+        for (uint8_t e=0;e<L2_EVENT_NB;e++)
+        {
+            if (transitionCnt[s][e] == 0)
+                continue;
+
+            debug("[L2]   state %i, event %i : cnt %i, avg %i us, max %i us\n", s, e,
+                transitionCnt[s][e], L2_FSMengine_getAvgLatency(s, (L2_event_e)e), L2_FSMengine_getMaxLatency(s, (L2_event_e)e));
+        }
+    }
+}
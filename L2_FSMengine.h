@@ -0,0 +1,39 @@
+#ifndef L2_FSMENGINE_H
+#define L2_FSMENGINE_H
+
+#include "mbed.h"
+#include "L2_FSMevent.h"
+
+#define L2_FSMENGINE_MAXSTATE       4
+
+//transition handler : called with the event already cleared, returns the next state
+typedef uint8_t (*L2_FSMhandler_t)(uint8_t state, L2_event_e event);
+
+//one (event -> handler) entry of a state
+typedef struct
+{
+    L2_event_e event;
+    L2_FSMhandler_t handler;
+} L2_FSMtransition_t;
+
+//one row of the state x event table, transitions are listed in priority order
+typedef struct
+{
+    const L2_FSMtransition_t* transitions;
+    uint8_t nbTransitions;
+} L2_FSMstate_t;
+
+#define L2_FSM_NBTRANSITIONS(t)     ((uint8_t)(sizeof(t)/sizeof((t)[0])))
+
+
+void L2_FSMengine_init(const L2_FSMstate_t* table, uint8_t nbStates);
+uint8_t L2_FSMengine_dispatch(uint8_t state);
+
+uint32_t L2_FSMengine_getCount(uint8_t state, L2_event_e event);
+uint32_t L2_FSMengine_getMaxLatency(uint8_t state, L2_event_e event);
+uint32_t L2_FSMengine_getAvgLatency(uint8_t state, L2_event_e event);
+uint32_t L2_FSMengine_getNbDispatch(void);
+void L2_FSMengine_resetStats(void);
+void L2_FSMengine_printStats(void);
+
+#endif
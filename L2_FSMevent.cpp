@@ -1,7 +1,7 @@
 #include "mbed.h"
 #include "L2_FSMevent.h"
 
-static uint32_t eventFlag;
+static volatile uint32_t eventFlag;
 
 
 void L2_event_setEventFlag(L2_event_e event)
@@ -21,4 +21,9 @@ void L2_event_clearAllEventFlag(void)
 int L2_event_checkEventFlag(L2_event_e event)
 {
     return (eventFlag & (0x01 << event));
-}
\ No newline at end of file
+}
+
+uint32_t L2_event_getEventFlags(void)
+{
+    return eventFlag;
+}
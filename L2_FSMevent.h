@@ -1,3 +1,8 @@
+#ifndef L2_FSMEVENT_H
+#define L2_FSMEVENT_H
+
+#include "mbed.h"
+
 typedef enum L2_event
 {
     L2_event_dataTxDone = 0,
@@ -10,9 +15,13 @@ typedef enum L2_event
     L2_event_dataToSendBuffer = 7
 } L2_event_e;
 
+#define L2_EVENT_NB                 8
+
 
 void L2_event_setEventFlag(L2_event_e event);
 void L2_event_clearEventFlag(L2_event_e event);
 void L2_event_clearAllEventFlag(void);
 int L2_event_checkEventFlag(L2_event_e event);
+uint32_t L2_event_getEventFlags(void);
 
+#endif
@@ -1,4 +1,5 @@
 #include "L2_FSMevent.h"
+#include "L2_FSMengine.h"
 #include "L2_msg.h"
 #include "L2_timer.h"
 #include "L2_LLinterface.h"
@@ -10,6 +11,9 @@
 #define L2STATE_TX                1
 #ifndef DISABLE_ARQ
 #define L2STATE_ACK               2
+#define L2STATE_NB                3
+#else
+#define L2STATE_NB                2
 #endif
 
 #define SDUBUFFER_SIZE              1024
@@ -33,6 +37,27 @@ static uint8_t sduLen;
 
 static uint8_t pduBuffer[SDUBUFFER_SIZE];
 static uint8_t pduBufferSize;
+
+//broadcast reassembly (kept apart so group frames never mix with a unicast SDU)
+static uint8_t brPduBuffer[L2_TXQUEUE_MAXSDUSIZE];
+static uint8_t brPduBufferSize = 0;
+static uint8_t brSrcId = 0;
+
+//TX request queue (DATA_REQ from L3), SDUs are sent one at a time
+typedef struct
+{
+    uint8_t handle;
+    uint8_t destId;
+    uint8_t len;
+    uint8_t sdu[L2_TXQUEUE_MAXSDUSIZE];
+} L2_txRequest_t;
+
+static L2_txRequest_t txQueue[L2_TXQUEUE_SIZE];
+static uint8_t txQueueHead = 0;
+static volatile uint8_t txQueueCount = 0;
+static uint8_t txNextHandle = 1;
+static volatile uint8_t txCurHandle = 0;    //handle of the SDU being sent (0 : none)
+static uint8_t txLastFragment = 0;          //PDU in flight carries the end of the SDU
 //ARQ parameters -------------------------------------------------------------
 static uint8_t seqNum = 0;     //ARQ sequence number
 #ifndef DISABLE_ARQ
@@ -93,31 +118,97 @@ int L2_pullSduBuffer(uint8_t size)
     return res;
 }
 
-void L2_LLI_handleDataReq(uint8_t* sdu, uint8_t len, uint8_t destId)
+//takes the next queued SDU if no SDU is being sent
+static void L2_startNextRequest(void)
 {
-    if (L2_configDestId(destId) == 1 && L2_event_checkEventFlag(L2_event_dataToSendBuffer))
+    L2_txRequest_t* req;
+
+    core_util_critical_section_enter();
+    if (txCurHandle != 0 || txQueueCount == 0)
     {
-        debug_if(DBGMSG_L2, "[L2] Failed to handle DATA_REQ (dest ID is invalid or data TX is in progress...(SDU flag : %i)\n", L2_event_checkEventFlag(L2_event_dataToSendBuffer));
+        core_util_critical_section_exit();
         return;
     }
+    req = &txQueue[txQueueHead];
+    txCurHandle = req->handle;
+    core_util_critical_section_exit();
 
-    if (len < L2_MSG_MAXDATASIZE)
+    destL2ID = req->destId;
+    if (req->len < L2_MSG_MAXDATASIZE)
     {
-        memcpy(sduIn, sdu, len);
-        sduLen = len;
+        memcpy(sduIn, req->sdu, req->len);
+        sduLen = req->len;
     }
     else
     {
-        memcpy(sduBuffer, sdu, len);
-        sduBufferSize = len;
+        memcpy(sduBuffer, req->sdu, req->len);
+        sduBufferSize = req->len;
 
-        L2_pullSduBuffer(L2_MSG_MAXDATASIZE);
-        L2_event_setEventFlag(L2_event_dataToSendBuffer);
+        if (L2_pullSduBuffer(L2_MSG_MAXDATASIZE) != 0)
+            L2_event_setEventFlag(L2_event_dataToSendBuffer);
     }
 
+    core_util_critical_section_enter();
+    txQueueHead = (txQueueHead + 1)%L2_TXQUEUE_SIZE;
+    txQueueCount--;
+    core_util_critical_section_exit();
+
     L2_event_setEventFlag(L2_event_dataToSend);
 }
 
+//the SDU being sent is finished (res 1 : delivered, 0 : failed), report it and go on with the queue
+static void L2_completeRequest(uint8_t res)
+{
+    uint8_t handle = txCurHandle;
+
+    if (res == 0)
+    {
+        //drop the remaining fragments
+        L2_event_clearEventFlag(L2_event_dataToSendBuffer);
+        sduBufferSize = 0;
+    }
+
+    txCurHandle = 0;
+    L3_LLI_dataCnf(handle, res);
+    L2_startNextRequest();
+}
+
+//DATA_REQ : queues the SDU and returns its handle (0 : rejected)
+uint8_t L2_LLI_handleDataReq(uint8_t* sdu, uint8_t len, uint8_t destId)
+{
+    uint8_t handle;
+
+    if (destId == myL2ID || len == 0 || len > L2_TXQUEUE_MAXSDUSIZE)
+    {
+        debug("[L2][WARNING] Failed to handle DATA_REQ (dest:%i, len:%i)\n", destId, len);
+        return 0;
+    }
+
+    core_util_critical_section_enter();
+    if (txQueueCount >= L2_TXQUEUE_SIZE)
+    {
+        core_util_critical_section_exit();
+        debug_if(DBGMSG_L2, "[L2] Failed to handle DATA_REQ (TX queue is full)\n");
+        return 0;
+    }
+
+    L2_txRequest_t* req = &txQueue[(txQueueHead + txQueueCount)%L2_TXQUEUE_SIZE];
+    req->handle = txNextHandle;
+    req->destId = destId;
+    req->len = len;
+    memcpy(req->sdu, sdu, len);
+    txQueueCount++;
+
+    handle = txNextHandle;
+    txNextHandle++;
+    if (txNextHandle == 0)
+        txNextHandle = 1;
+    core_util_critical_section_exit();
+
+    L2_startNextRequest();
+    return handle;
+}
+
 void L2_LLI_reconfigSrcId(uint8_t myId)
 {
     reqestedId = myId;
@@ -125,29 +216,51 @@ void L2_LLI_reconfigSrcId(uint8_t myId)
 }
 
 
-void L2_initFSM(uint8_t myId)
+//broadcast SDUs are reassembled per source, without ARQ : a lost fragment yields a
+//wrong-sized SDU that the upper layer has to detect (and repair, e.g. group NACK)
+static int L2_aggregateBroadcast(uint8_t* dataPtr, uint8_t srcId, uint8_t size, uint8_t flag_end)
 {
-    myL2ID = myId;
-    destL2ID = 0; 
+    uint8_t len = size - L2_MSG_OFFSET_DATA;
 
-    L2_event_clearAllEventFlag();
+    //fragments of another source : the previous SDU lost its end, drop it
+    if (brPduBufferSize > 0 && brSrcId != srcId)
+    {
+        debug_if(DBGMSG_L2, "[L2] broadcast SDU from %i truncated by %i, discarding\n", brSrcId, srcId);
+        brPduBufferSize = 0;
+    }
+    if (brPduBufferSize + len > L2_TXQUEUE_MAXSDUSIZE)
+    {
+        debug("[L2][WARNING] broadcast SDU from %i too long, discarding\n", srcId);
+        brPduBufferSize = 0;
+        return 0;
+    }
 
-    L2_validityCheck_ID();
+    brSrcId = srcId;
+    memcpy(brPduBuffer+brPduBufferSize, L2_msg_getWord(dataPtr), len);
+    brPduBufferSize += len;
 
-    L2_LLI_initLowLayer(myL2ID);
-    L3_LLI_setDataReqFunc(L2_LLI_handleDataReq);
-    L3_LLI_setReconfigSrcIdReqFunc(L2_LLI_reconfigSrcId);
-}
+    debug_if(DBGMSG_L2, "[L2] Aggregation broadcast PDU : size : %i end : %i\n", brPduBufferSize, flag_end);
+    if (flag_end == 1)
+    {
+        L3_LLI_dataInd(brPduBuffer, srcId, brPduBufferSize, L2_LLI_getSnr(), L2_LLI_getRssi());
+        brPduBufferSize = 0;
 
+        return 0;
+    }
 
+    return 1;
+}
 
 int L2_aggregateData(uint8_t* dataPtr, uint8_t srcId, uint8_t size, uint8_t brflag, uint8_t flag_end)
 {
+    if (brflag == 1)
+        return L2_aggregateBroadcast(dataPtr, srcId, size, flag_end);
+
     memcpy(pduBuffer+pduBufferSize,L2_msg_getWord(dataPtr), size);
     pduBufferSize+=size-L2_MSG_OFFSET_DATA;
 
     debug_if(DBGMSG_L2, "[L2] Aggregation PDU : size : %i end : %i\n", pduBufferSize, flag_end);
-    if (brflag == 1 || flag_end == 1)
+    if (flag_end == 1)
     {
         L3_LLI_dataInd(pduBuffer, srcId, pduBufferSize, L2_LLI_getSnr(), L2_LLI_getRssi());
         pduBufferSize = 0;
@@ -159,259 +272,229 @@ int L2_aggregateData(uint8_t* dataPtr, uint8_t srcId, uint8_t size, uint8_t brfl
 }
 
 
-void L2_FSMrun(void)
+//FSM transitions -------------------------------------------
+//src id reconfiguration request (IDLE)
+static uint8_t L2_FSM_reconfigSrcId(uint8_t state, L2_event_e event)
 {
-    //debug message
-    if (prev_state != main_state)
-    {
-        debug_if(DBGMSG_L2, "[L2] State transition from %i to %i\n", prev_state, main_state);
-        prev_state = main_state;
-    }
+    int res;
+    res = L2_LLI_configSrcId(reqestedId);
 
-    //FSM should be implemented here! ---->>>>
-    switch (main_state)
-    {
-        case L2STATE_IDLE: //IDLE state description
-            
-            if (L2_event_checkEventFlag(L2_event_reconfigSrcId)) //if src id reconfiguration is requested
-            {
-                int res;
-                res = L2_LLI_configSrcId(reqestedId);
-
-                L3_LLI_reconfigSrcIdCnf(res==0);
-                main_state = L2STATE_IDLE; //goto TX state
-                L2_event_clearEventFlag(L2_event_reconfigSrcId);
-            }
-            else if (L2_event_checkEventFlag(L2_event_dataRcvd)) //if data reception event happens
-            {
-                //Retrieving data info.
-                uint8_t srcId = L2_LLI_getSrcId();
-                uint8_t* dataPtr = L2_LLI_getRcvdDataPtr();
-                uint8_t size = L2_LLI_getSize();
-                uint8_t brflag = L2_LLI_getIsBroadcasted();
-                uint8_t flag_end = L2_msg_checkIfEndData(dataPtr);
-
-                //L3_LLI_dataInd(L2_msg_getWord(dataPtr), srcId, size-L2_MSG_OFFSET_DATA, L2_LLI_getSnr(), L2_LLI_getRssi());
-#ifndef DISABLE_ARQ                
-                if (brflag == 0 && seqNum != L2_msg_getSeq(dataPtr))
-                    debug("[L3][WARNING] Invalid PDU SN (%i) while (%i) is required! discarding it...\n", L2_msg_getSeq(dataPtr), seqNum);
-                else{
-                    L2_aggregateData(dataPtr, srcId, size, brflag, flag_end);
-                }
-#else
-                // 이 부분은 ARQ가 비활성화되었을 때 (DISABLE_ARQ가 정의된 경우) 실행됩니다.
-                // 이제 srcId가 선언되어 사용 가능합니다.
-                L2_aggregateData(dataPtr, srcId, size, brflag, flag_end);
-#endif
-                L2_event_clearEventFlag(L2_event_dataRcvd);
+    L3_LLI_reconfigSrcIdCnf(res==0);
+    return L2STATE_IDLE;
+}
 
+//data reception (IDLE, ACK)
+static uint8_t L2_FSM_dataRcvd(uint8_t state, L2_event_e event)
+{
+    //Retrieving data info.
+    uint8_t srcId = L2_LLI_getSrcId();
+    uint8_t* dataPtr = L2_LLI_getRcvdDataPtr();
+    uint8_t size = L2_LLI_getSize();
+    uint8_t brflag = L2_LLI_getIsBroadcasted();
+    uint8_t flag_end = L2_msg_checkIfEndData(dataPtr);
 
 #ifdef DISABLE_ARQ
-                main_state = L2STATE_IDLE;
+    L2_aggregateData(dataPtr, srcId, size, brflag, flag_end);
+    return L2STATE_IDLE;
 #else
-                if (brflag)
-                {
-                    main_state = L2STATE_IDLE;
-                }
-                else
-                {
-                    //ACK transmission
-                    if (brflag == 0 && seqNum == L2_msg_getSeq(dataPtr))
-                        seqNum = (seqNum + 1)%L2_MSSG_MAX_SEQNUM;
-                    L2_msg_encodeAck(arqAck, L2_msg_getSeq(dataPtr));
-                    L2_LLI_sendData(arqAck, L2_MSG_ACKSIZE, srcId);
-
-                    main_state = L2STATE_TX; //goto TX state
-                }
+    if (brflag == 0 && seqNum != L2_msg_getSeq(dataPtr))
+        debug("[L3][WARNING] Invalid PDU SN (%i) while (%i) is required! discarding it...\n", L2_msg_getSeq(dataPtr), seqNum);
+    else
+        L2_aggregateData(dataPtr, srcId, size, brflag, flag_end);
+
+    if (brflag)
+        return L2STATE_IDLE;
+
+    //ACK transmission
+    if (seqNum == L2_msg_getSeq(dataPtr))
+        seqNum = (seqNum + 1)%L2_MSSG_MAX_SEQNUM;
+    L2_msg_encodeAck(arqAck, L2_msg_getSeq(dataPtr));
+    L2_LLI_sendData(arqAck, L2_MSG_ACKSIZE, srcId);
+
+    return L2STATE_TX; //goto TX state
 #endif
-                L2_event_clearEventFlag(L2_event_dataRcvd);
-            }
-            else if (L2_event_checkEventFlag(L2_event_dataToSend)) //if data needs to be sent (keyboard input)
-            {
-                //msg header setting
-                pduSize = L2_msg_encodeData(arqPdu, sduIn, seqNum, sduLen, L2_event_checkEventFlag(L2_event_dataToSendBuffer) == 0);
-                L2_LLI_sendData(arqPdu, pduSize, destL2ID);
+}
+
+//data needs to be sent (IDLE)
+static uint8_t L2_FSM_dataToSend(uint8_t state, L2_event_e event)
+{
+    //msg header setting
+    txLastFragment = (L2_event_checkEventFlag(L2_event_dataToSendBuffer) == 0);
+    pduSize = L2_msg_encodeData(arqPdu, sduIn, seqNum, sduLen, txLastFragment);
+    L2_LLI_sendData(arqPdu, pduSize, destL2ID);
 
 #ifndef DISABLE_ARQ
-                //Setting ARQ parameter 
-                if (destL2ID != L2_BROADCAST_ID)
-                    seqNum = (seqNum + 1)%L2_MSSG_MAX_SEQNUM;
-                retxCnt = 0;
+    //Setting ARQ parameter 
+    if (destL2ID != L2_BROADCAST_ID)
+        seqNum = (seqNum + 1)%L2_MSSG_MAX_SEQNUM;
+    retxCnt = 0;
 #endif
-                debug_if(DBGMSG_L2, "[L2] sending to %i (seq:%i)\n", destL2ID, (seqNum-1)%L2_MSSG_MAX_SEQNUM);
+    debug_if(DBGMSG_L2, "[L2] sending to %i (seq:%i)\n", destL2ID, (seqNum-1)%L2_MSSG_MAX_SEQNUM);
 
-                main_state = L2STATE_TX;
+    return L2STATE_TX;
+}
 
-                L2_event_clearEventFlag(L2_event_dataToSend);
-            }
-            else if (L2_event_checkEventFlag(L2_event_dataToSendBuffer))
-            {
-                L2_event_setEventFlag(L2_event_dataToSend);
+//next fragment of a segmented SDU (IDLE)
+static uint8_t L2_FSM_dataToSendBuffer(uint8_t state, L2_event_e event)
+{
+    L2_event_setEventFlag(L2_event_dataToSend);
 
-                if (L2_pullSduBuffer(L2_MSG_MAXDATASIZE) == 0)
-                    L2_event_clearEventFlag(L2_event_dataToSendBuffer);
-            }
-#ifndef DISABLE_ARQ
-            //ignore events (arqEvent_dataTxDone, arqEvent_ackTxDone, arqEvent_ackRcvd, arqEvent_arqTimeout)
-            else if (L2_event_checkEventFlag(L2_event_dataTxDone)) //if data needs to be sent (keyboard input)
-            {
-                debug_if(DBGMSG_L2, "[L2][WARNING] cannot happen in IDLE state (event %i)\n", L2_event_dataTxDone);
-                L2_event_clearEventFlag(L2_event_dataTxDone);
-            }
-            else if (L2_event_checkEventFlag(L2_event_ackTxDone)) //if data needs to be sent (keyboard input)
-            {
-                debug_if(DBGMSG_L2, "[L2][WARNING] cannot happen in IDLE state (event %i)\n", L2_event_ackTxDone);
-                L2_event_clearEventFlag(L2_event_ackTxDone);
-            }
-            else if (L2_event_checkEventFlag(L2_event_dataTxDone)) //if data needs to be sent (keyboard input)
-            {
-                debug_if(DBGMSG_L2, "[L2][WARNING] cannot happen in IDLE state (event %i)\n", L2_event_ackRcvd);
-                L2_event_clearEventFlag(L2_event_ackRcvd);
-            }
-            else if (L2_event_checkEventFlag(L2_event_arqTimeout)) //if data needs to be sent (keyboard input)
-            {
-                debug_if(DBGMSG_L2, "[WARNING] cannot happen in IDLE state (event %i)\n", L2_event_arqTimeout);
-                L2_event_clearEventFlag(L2_event_arqTimeout);
-            }   
-#endif
-            break;
+    if (L2_pullSduBuffer(L2_MSG_MAXDATASIZE) != 0)
+        L2_event_setEventFlag(L2_event_dataToSendBuffer);
 
-        case L2STATE_TX: //TX state description
+    return L2STATE_IDLE;
+}
 
-#ifndef DISABLE_ARQ
-            if (L2_event_checkEventFlag(L2_event_ackTxDone)) //data TX finished
-            {
-                if (L2_timer_getTimerStatus() == 1 ||
-                    L2_event_checkEventFlag(L2_event_arqTimeout))
-                {
-                    main_state = L2STATE_ACK;
-                }
-                else
-                {
-                    main_state = L2STATE_IDLE;
-                }
-
-                L2_event_clearEventFlag(L2_event_ackTxDone);
-            }
-            else 
-#endif
-            {
-                if (L2_event_checkEventFlag(L2_event_dataTxDone)) //data TX finished
-                {
+//data TX finished (TX)
+static uint8_t L2_FSM_dataTxDone(uint8_t state, L2_event_e event)
+{
 #ifdef DISABLE_ARQ
-                    main_state = L2STATE_IDLE;
-                    L3_LLI_dataCnf(1);
+    if (txLastFragment)
+        L2_completeRequest(1);
+    return L2STATE_IDLE;
 #else
-                    if (destL2ID == L2_BROADCAST_ID)
-                    {
-                        main_state = L2STATE_IDLE;
-                         L3_LLI_dataCnf(1);
-                    }
-                    else
-                    {
-                        main_state = L2STATE_ACK;
-                        L2_timer_startTimer(); //start ARQ timer for retransmission
-                    }
+    if (destL2ID == L2_BROADCAST_ID)
+    {
+        if (txLastFragment)
+            L2_completeRequest(1);
+        return L2STATE_IDLE;
+    }
+
+    L2_timer_startTimer(retxCnt); //start ARQ timer for retransmission
+    return L2STATE_ACK;
 #endif
-                    L2_event_clearEventFlag(L2_event_dataTxDone);
-                }
-            }
+}
 
-            break;
+#ifndef DISABLE_ARQ
+//ACK TX finished (TX)
+static uint8_t L2_FSM_ackTxDone(uint8_t state, L2_event_e event)
+{
+    if (L2_timer_getTimerStatus() == 1 ||
+        L2_event_checkEventFlag(L2_event_arqTimeout))
+    {
+        return L2STATE_ACK;
+    }
 
+    return L2STATE_IDLE;
+}
+
+//ACK reception (ACK)
+static uint8_t L2_FSM_ackRcvd(uint8_t state, L2_event_e event)
+{
+    uint8_t* dataPtr = L2_LLI_getRcvdDataPtr();
+    if ( L2_msg_getSeq(arqPdu) == L2_msg_getSeq(dataPtr) )
+    {
+        debug_if(DBGMSG_L2, "[L2] ACK is correctly received! \n");
+        L2_timer_stopTimer();
+        if (txLastFragment)
+            L2_completeRequest(1);
+        return L2STATE_IDLE;
+    }
+
+    debug_if(DBGMSG_L2, "[L2]ACK seq number is weird! (expected : %i, received : %i\n", L2_msg_getSeq(arqPdu),L2_msg_getSeq(dataPtr));
+    return state;
+}
+
+//ARQ timeout (ACK)
+static uint8_t L2_FSM_arqTimeout(uint8_t state, L2_event_e event)
+{
+    if (retxCnt >= L2_ARQ_MAXRETRANSMISSION)
+    {
+        debug("[L2][WARNING] Failed to send data %i, max retx cnt reached! \n", L2_msg_getSeq(arqPdu));
+        L2_completeRequest(0);
+        return L2STATE_IDLE;
+    }
+
+    //retx < max, then goto TX for retransmission
+    debug_if(DBGMSG_L2, "[L2] timeout! retransmit\n");
+    L2_LLI_sendData(arqPdu, pduSize, destL2ID);
+    //Setting ARQ parameter 
+    retxCnt += 1;
+    return L2STATE_TX;
+}
+
+//events that cannot happen in the current state are consumed with a warning
+static uint8_t L2_FSM_ignoreEvent(uint8_t state, L2_event_e event)
+{
+    debug_if(DBGMSG_L2, "[L2][WARNING] cannot happen in state %i (event %i)\n", state, event);
+    return state;
+}
+#endif
+
+
+//FSM table (state x event), transitions in priority order ------------
+static const L2_FSMtransition_t L2_idleTransitions[] =
+{
+    {L2_event_reconfigSrcId,    L2_FSM_reconfigSrcId},
+    {L2_event_dataRcvd,         L2_FSM_dataRcvd},
+    {L2_event_dataToSend,       L2_FSM_dataToSend},
+    {L2_event_dataToSendBuffer, L2_FSM_dataToSendBuffer},
 #ifndef DISABLE_ARQ
-        case L2STATE_ACK: //ACK state description
-
-            if (L2_event_checkEventFlag(L2_event_ackRcvd)) //data TX finished
-            {
-                uint8_t* dataPtr = L2_LLI_getRcvdDataPtr();
-                if ( L2_msg_getSeq(arqPdu) == L2_msg_getSeq(dataPtr) )
-                {
-                    debug_if(DBGMSG_L2, "[L2] ACK is correctly received! \n");
-                    L2_timer_stopTimer();
-                    main_state = L2STATE_IDLE;
-                    L3_LLI_dataCnf(1);
-                }
-                else
-                {
-                    debug_if(DBGMSG_L2, "[L2]ACK seq number is weird! (expected : %i, received : %i\n", L2_msg_getSeq(arqPdu),L2_msg_getSeq(dataPtr));
-                }
-
-                L2_event_clearEventFlag(L2_event_ackRcvd);
-            }
-            else if (L2_event_checkEventFlag(L2_event_arqTimeout)) //data TX finished
-            {
-                if (retxCnt >= L2_ARQ_MAXRETRANSMISSION)
-                {
-                    debug("[L2][WARNING] Failed to send data %i, max retx cnt reached! \n", L2_msg_getSeq(arqPdu));
-                    main_state = L2STATE_IDLE;
-                    L3_LLI_dataCnf(0);
-                    //arqPdu clear
-                    //retxCnt clear
-                }
-                else //retx < max, then goto TX for retransmission
-                {
-                    debug_if(DBGMSG_L2, "[L2] timeout! retransmit\n");
-                    L2_LLI_sendData(arqPdu, pduSize, destL2ID);
-                    //Setting ARQ parameter 
-                    retxCnt += 1;
-                    main_state = L2STATE_TX;
-                }
-
-                L2_event_clearEventFlag(L2_event_arqTimeout);
-            }
-            else if (L2_event_checkEventFlag(L2_event_dataRcvd)) //data TX finished
-            {
-                //Retrieving data info.
-                uint8_t srcId = L2_LLI_getSrcId();
-                uint8_t* dataPtr = L2_LLI_getRcvdDataPtr();
-                uint8_t size = L2_LLI_getSize();
-                uint8_t brflag = L2_LLI_getIsBroadcasted();
-                uint8_t flag_end = L2_msg_checkIfEndData(dataPtr);
-
-                //L3_LLI_dataInd(L2_msg_getWord(dataPtr), srcId, size-L2_MSG_OFFSET_DATA, L2_LLI_getSnr(), L2_LLI_getRssi());
-#ifndef DISABLE_ARQ                
-                if (brflag == 0 && seqNum != L2_msg_getSeq(dataPtr))
-                    debug("[L3][WARNING] Invalid PDU SN (%i) while (%i) is required! discarding it...\n", L2_msg_getSeq(dataPtr), seqNum);
-                else
+    {L2_event_dataTxDone,       L2_FSM_ignoreEvent},
+    {L2_event_ackTxDone,        L2_FSM_ignoreEvent},
+    {L2_event_ackRcvd,          L2_FSM_ignoreEvent},
+    {L2_event_arqTimeout,       L2_FSM_ignoreEvent},
 #endif
-                    L2_aggregateData(dataPtr, srcId, size, brflag, flag_end);            
+};
 
-#ifdef DISABLE_ARQ
-                main_state = L2STATE_IDLE;
-#else
-                if (brflag)
-                {
-                    main_state = L2STATE_IDLE;
-                }
-                else
-                {
-                    //ACK transmission
-                    if (brflag == 0 && seqNum == L2_msg_getSeq(dataPtr))
-                        seqNum = (seqNum + 1)%L2_MSSG_MAX_SEQNUM;
-                    L2_msg_encodeAck(arqAck, L2_msg_getSeq(dataPtr));
-                    L2_LLI_sendData(arqAck, L2_MSG_ACKSIZE, srcId);
-
-                    main_state = L2STATE_TX; //goto TX state
-                }
+static const L2_FSMtransition_t L2_txTransitions[] =
+{
+#ifndef DISABLE_ARQ
+    {L2_event_ackTxDone,        L2_FSM_ackTxDone},
 #endif
-                L2_event_clearEventFlag(L2_event_dataRcvd);
-            }
-            else if (L2_event_checkEventFlag(L2_event_dataTxDone)) //data TX finished
-            {
-                debug_if(DBGMSG_L2, "[L2][WARNING] cannot happen in ACK state (event %i)\n", L2_event_dataTxDone);
-                L2_event_clearEventFlag(L2_event_dataTxDone);
-            }
-            else if (L2_event_checkEventFlag(L2_event_ackTxDone)) //data TX finished
-            {
-                debug_if(DBGMSG_L2, "[L2][WARNING] cannot happen in ACK state (event %i)\n", L2_event_ackTxDone);
-                L2_event_clearEventFlag(L2_event_ackTxDone);
-            }
-
-            break;
+    {L2_event_dataTxDone,       L2_FSM_dataTxDone},
+};
+
+#ifndef DISABLE_ARQ
+static const L2_FSMtransition_t L2_ackTransitions[] =
+{
+    {L2_event_ackRcvd,          L2_FSM_ackRcvd},
+    {L2_event_arqTimeout,       L2_FSM_arqTimeout},
+    {L2_event_dataRcvd,         L2_FSM_dataRcvd},
+    {L2_event_dataTxDone,       L2_FSM_ignoreEvent},
+    {L2_event_ackTxDone,        L2_FSM_ignoreEvent},
+};
+#endif
+
+//indexed by L2STATE_xxx
+static const L2_FSMstate_t L2_FSMtable[L2STATE_NB] =
+{
+    {L2_idleTransitions,    L2_FSM_NBTRANSITIONS(L2_idleTransitions)},
+    {L2_txTransitions,      L2_FSM_NBTRANSITIONS(L2_txTransitions)},
+#ifndef DISABLE_ARQ
+    {L2_ackTransitions,     L2_FSM_NBTRANSITIONS(L2_ackTransitions)},
 #endif
-        default :
-            break;
+};
+
+
+void L2_initFSM(uint8_t myId)
+{
+    myL2ID = myId;
+    destL2ID = 0; 
+
+    txQueueHead = 0;
+    txQueueCount = 0;
+    txCurHandle = 0;
+
+    L2_event_clearAllEventFlag();
+    L2_FSMengine_init(L2_FSMtable, L2STATE_NB);
+
+    L2_validityCheck_ID();
+
+    L2_LLI_initLowLayer(myL2ID);
+    L3_LLI_setDataReqFunc(L2_LLI_handleDataReq);
+    L3_LLI_setReconfigSrcIdReqFunc(L2_LLI_reconfigSrcId);
+}
+
+
+void L2_FSMrun(void)
+{
+    //debug message
+    if (prev_state != main_state)
+    {
+        debug_if(DBGMSG_L2, "[L2] State transition from %i to %i\n", prev_state, main_state);
+        prev_state = main_state;
     }
 
-}
\ No newline at end of file
+    main_state = L2_FSMengine_dispatch(main_state);
+}
@@ -2,6 +2,7 @@
 #include "PHYMAC_layer.h"
 #include "L2_FSMevent.h"
 #include "L2_msg.h"
+#include "L2_backoff.h"
 #include "protocol_parameters.h"
 #include "time.h"
 
@@ -34,7 +35,7 @@ void L2_LLI_dataIndFunc(uint8_t srcId, uint8_t* dataPtr, uint8_t size, uint8_t B
 {
     debug_if(DBGMSG_L2, "\n[L2]  --> DATA IND : src:%i, size:%i type : %i BR : %i\n", srcId, size, dataPtr[0], BR);
 
-    if ((float)rand()/RAND_MAX > L2_LLI_PKT_LOSS)
+    if ((float)L2_backoff_randRange(10000)/10000 >= L2_LLI_PKT_LOSS)
     {
         memcpy(rcvdData, dataPtr, size*sizeof(uint8_t));
         rcvdSrc = srcId;
@@ -62,7 +63,7 @@ void L2_LLI_dataIndFunc(uint8_t srcId, uint8_t* dataPtr, uint8_t size, uint8_t B
 
 void L2_LLI_initLowLayer(uint8_t srcId)
 {
-    srand(time(NULL));
+    L2_backoff_init(srcId);
     phymac_init(srcId, L2_LLI_dataCnfFunc, L2_LLI_dataIndFunc);
 }
 
@@ -0,0 +1,65 @@
+#include "mbed.h"
+#include "L2_backoff.h"
+
+static uint32_t state = 1;    //xorshift32 state (never 0)
+
+
+//32 bit finalizer (murmur3), spreads close inputs such as consecutive node IDs over the whole state
+static uint32_t mix(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x85EBCA6B;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35;
+    x ^= x >> 16;
+    return x;
+}
+
+void L2_backoff_init(uint8_t nodeId)
+{
+    uint32_t seed = mix(nodeId);
+#ifdef UID_BASE
+    //96 bit factory-programmed unique ID
+    const uint32_t* uid = (const uint32_t*)UID_BASE;
+    seed = mix(seed ^ uid[0]);
+    seed = mix(seed ^ uid[1]);
+    seed = mix(seed ^ uid[2]);
+#endif
+    //the ID is typed in by hand, so the ticker at this point also differs between boards
+    seed = mix(seed ^ us_ticker_read());
+
+    state = (seed != 0) ? seed : 0x6D2B79F5;
+}
+
+//also called from the RX ISR (packet loss check), so the state update is a critical section
+uint32_t L2_backoff_rand(void)
+{
+    core_util_critical_section_enter();
+    uint32_t x = state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state = x;
+    core_util_critical_section_exit();
+    return x;
+}
+
+uint32_t L2_backoff_randRange(uint32_t range)
+{
+    if (range == 0)
+        return 0;
+
+    return L2_backoff_rand() % range;
+}
+
+uint32_t L2_backoff_jitterMs(uint32_t baseMs, uint32_t capMs, uint8_t attempt)
+{
+    uint32_t windowMs = baseMs;
+    for (uint8_t i=0;i<attempt && windowMs < capMs;i++)
+        windowMs *= 2;
+
+    if (windowMs > capMs)
+        windowMs = capMs;
+
+    return L2_backoff_randRange(windowMs + 1);
+}
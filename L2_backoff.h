@@ -0,0 +1,21 @@
+#ifndef L2_BACKOFF_H
+#define L2_BACKOFF_H
+
+#include "mbed.h"
+
+//per-node random numbers and retry backoff, shared by the L2 ARQ timer and the L3 retries
+//the generator is seeded from the MCU unique ID, the node ID and the ticker at start-up,
+//so nodes that boot together do not draw the same backoffs (rand() seeded with time(NULL) did, as there is no RTC)
+
+void L2_backoff_init(uint8_t nodeId);
+
+//next 32 bit random number
+uint32_t L2_backoff_rand(void);
+
+//uniform in [0, range) (0 when range is 0)
+uint32_t L2_backoff_randRange(uint32_t range);
+
+//exponential backoff with full jitter : uniform in [0, min(capMs, baseMs * 2^attempt)]
+uint32_t L2_backoff_jitterMs(uint32_t baseMs, uint32_t capMs, uint8_t attempt);
+
+#endif
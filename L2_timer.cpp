@@ -1,5 +1,6 @@
 #include "mbed.h"
 #include "L2_FSMevent.h"
+#include "L2_backoff.h"
 #include "protocol_parameters.h"
 
 
@@ -17,10 +18,12 @@ void L2_timer_timeoutHandler(void)
 }
 
 //timer related functions ---------------------------
-void L2_timer_startTimer()
+//ARQ timeout : minimum wait + exponential backoff with full jitter over the retransmissions (up to the maximum wait)
+void L2_timer_startTimer(uint8_t retxCnt)
 {
-    uint8_t waitTime = L2_ARQ_MINWAITTIME + rand()%(L2_ARQ_MAXWAITTIME-L2_ARQ_MINWAITTIME);
-    timer.attach(L2_timer_timeoutHandler, waitTime);
+    uint32_t waitMs = L2_ARQ_MINWAITTIME*1000 +
+        L2_backoff_jitterMs(L2_ARQ_BACKOFFBASEMS, (L2_ARQ_MAXWAITTIME-L2_ARQ_MINWAITTIME)*1000, retxCnt);
+    timer.attach_us(L2_timer_timeoutHandler, waitMs*1000);
     timerStatus = 1;
 }
 
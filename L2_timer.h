@@ -1,3 +1,3 @@
-void L2_timer_startTimer();
+void L2_timer_startTimer(uint8_t retxCnt);
 void L2_timer_stopTimer();
 uint8_t L2_timer_getTimerStatus();
\ No newline at end of file
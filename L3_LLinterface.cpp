@@ -10,9 +10,16 @@ static int16_t rcvdRssi;
 static int8_t rcvdSnr;
 static uint8_t rcvdSrcId;
 
+// L2 가 보고한 요청별 전송 결과 (handle, res)
+#define L3_LLI_CNFQUEUE_SIZE    8
+static uint8_t cnfHandle[L3_LLI_CNFQUEUE_SIZE];
+static uint8_t cnfRes[L3_LLI_CNFQUEUE_SIZE];
+static uint8_t cnfHead = 0;
+static uint8_t cnfCount = 0;
+
 //Downward primitives
 //TX function
-void (*L3_LLI_dataReqFunc)(uint8_t* msg, uint8_t size, uint8_t destId);
+uint8_t (*L3_LLI_dataReqFunc)(uint8_t* msg, uint8_t size, uint8_t destId);
 void (*L3_LLI_reconfigSrcIdReqFunc)(uint8_t myId);
 
 //interface event : DATA_IND, RX data has arrived
@@ -30,12 +37,41 @@ void L3_LLI_dataInd(uint8_t* dataPtr, uint8_t srcId, uint8_t size, int8_t snr, i
     L3_event_setEventFlag(L3_event_msgRcvd);
 }
 
-void L3_LLI_dataCnf(uint8_t res)
+void L3_LLI_dataCnf(uint8_t handle, uint8_t res)
 {
-    debug_if(DBGMSG_L3, "\n --> DATA CNF : res : %i\n", res);
+    debug_if(DBGMSG_L3, "\n --> DATA CNF : handle : %i, res : %i\n", handle, res);
+
+    if (cnfCount >= L3_LLI_CNFQUEUE_SIZE)
+    {
+        // 가장 오래된 결과를 버림
+        debug_if(DBGMSG_L3, "[L3][WARNING] DATA CNF queue full, dropping handle %i\n", cnfHandle[cnfHead]);
+        cnfHead = (cnfHead + 1) % L3_LLI_CNFQUEUE_SIZE;
+        cnfCount--;
+    }
+
+    uint8_t idx = (cnfHead + cnfCount) % L3_LLI_CNFQUEUE_SIZE;
+    cnfHandle[idx] = handle;
+    cnfRes[idx] = res;
+    cnfCount++;
+
     L3_event_setEventFlag(L3_event_dataSendCnf);
 }
 
+uint8_t L3_LLI_getDataCnf(uint8_t* handle, uint8_t* res)
+{
+    if (cnfCount == 0)
+    {
+        return 0;
+    }
+
+    *handle = cnfHandle[cnfHead];
+    *res = cnfRes[cnfHead];
+    cnfHead = (cnfHead + 1) % L3_LLI_CNFQUEUE_SIZE;
+    cnfCount--;
+
+    return 1;
+}
+
 void L3_LLI_reconfigSrcIdCnf(uint8_t res)
 {
     debug_if(DBGMSG_L3, "\n --> RECONFIG SRCID CNF : res : %i\n", res);
@@ -67,7 +103,7 @@ int8_t L3_LLI_getSnr()
     return rcvdSnr;
 }
 
-void L3_LLI_setDataReqFunc(void (*funcPtr)(uint8_t*, uint8_t, uint8_t))
+void L3_LLI_setDataReqFunc(uint8_t (*funcPtr)(uint8_t*, uint8_t, uint8_t))
 {
     L3_LLI_dataReqFunc = funcPtr;
 }
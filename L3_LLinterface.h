@@ -4,7 +4,8 @@
 
 #include "mbed.h"
 
-extern void (*L3_LLI_dataReqFunc)(uint8_t* msg, uint8_t size, uint8_t destId);
+// DATA_REQ : 요청 핸들 반환 (0 : L2 가 거부, 큐 가득 참 등)
+extern uint8_t (*L3_LLI_dataReqFunc)(uint8_t* msg, uint8_t size, uint8_t destId);
 
 void L3_LLI_dataInd(uint8_t* dataPtr, uint8_t srcId, uint8_t size, int8_t snr, int16_t rssi);
 uint8_t* L3_LLI_getMsgPtr();
@@ -12,9 +13,10 @@ uint8_t L3_LLI_getSize();
 uint8_t L3_LLI_getSrcId();
 int16_t L3_LLI_getRssi();  // Add RSSI getter
 int8_t L3_LLI_getSnr();     // Add SNR getter
-void L3_LLI_setDataReqFunc(void (*funcPtr)(uint8_t*, uint8_t, uint8_t));
+void L3_LLI_setDataReqFunc(uint8_t (*funcPtr)(uint8_t*, uint8_t, uint8_t));
 void L3_LLI_setReconfigSrcIdReqFunc(void (*funcPtr)(uint8_t));
-void L3_LLI_dataCnf(uint8_t res);
+void L3_LLI_dataCnf(uint8_t handle, uint8_t res);
+uint8_t L3_LLI_getDataCnf(uint8_t* handle, uint8_t* res); // 쌓인 DATA_CNF 하나 꺼냄, 없으면 0
 void L3_LLI_reconfigSrcIdCnf(uint8_t res);
 
 #endif // L3_LLINTERFACE_H
\ No newline at end of file
@@ -0,0 +1,1671 @@
+// L3_admin.cpp - 관리자(부스) 역할
+#include "L3_FSMevent.h"
+#include "L3_msg.h"
+#include "L3_msgHandler.h"
+#include "L3_role.h"
+#include "L3_types.h"
+#include "L3_LLinterface.h"
+#include "L3_deferred.h"
+#include "L3_registry.h"
+#include "L3_waitQueue.h"
+#include "L3_group.h"
+#include "L3_waitModel.h"
+#include "L3_federation.h"
+#include "L3_respCache.h"
+#include "L3_admission.h"
+#include "L2_backoff.h"
+#include "L3_trickle.h"
+#include "L3_timer.h"
+#include "protocol_parameters.h"
+#include "mbed.h"
+
+#define TIMER_CHECK_INTERVAL 1000000 // 1초마다 타이머 확인
+#define EXIT_DELAY_MS 500        // 세션 만료 후 다음 사용자 입장까지 간격
+#define EXIT_RESPONSE_GAP_MS 50  // EXIT_RESPONSE 후 다음 사용자 입장까지 간격
+#define QUEUE_INFO_GAP_MS 100    // REGISTER_RESPONSE 후 QUEUE_INFO 까지 간격
+
+// 부스 관리
+static uint8_t myId;                  // 관리자(부스)의 ID
+static Booth_t myBooth;               // 관리자용 부스 정보 구조체
+static uint8_t announcedCount = 0;    // 방송 간격 기준 상태: 이용자 수 (바뀌면 방송 간격 초기화)
+static uint8_t announcedWaiting = 0;  // 방송 간격 기준 상태: 대기 인원
+static uint8_t quietMode = 0;         // 관리자 방송 최소화 모드 (ON: 자동 방송 중지)
+static uint8_t infoVersion = L3_INFOVER_NONE; // 부스 정적 정보(설명, 정원) 버전 (사용자 캐시 키)
+
+// 세션 타이머 관련 변수
+static uint32_t sessionTimerCounter = 0; // 관리자 세션 타이머 체크 카운터
+
+// 대기열 관리 변수
+static uint8_t pendingUserId = 0;        // 큐 준비 응답을 기다리는 사용자 ID
+static uint32_t queueReadyStartTime = 0; // 큐 준비 타이머 시작 시각 (ms)
+static uint8_t isQueueReadyTimerActive = 0; // 큐 준비 타이머 활성화 여부
+static uint8_t isReservation = 0;        // 입장 알림이 세션 종료 전 예약 호출인지 (ADMISSION_LEAD_MS)
+static uint8_t isReservationAcked = 0;   // 예약 대상이 QUEUE_READY_ACK 로 미리 등록함 (자리가 비면 바로 입장)
+static uint32_t queueReadyTimeoutMs = QUEUE_READY_TIMEOUT_MS; // 현재 입장 알림의 응답 제한 시간 (멀리 있으면 단축)
+static uint8_t isPresenceProbing = 0;    // 호출한 사용자가 아직 멀리 있음: QUEUE_READY 를 주기적으로 다시 보냄
+static uint32_t lastProbeTime = 0;       // 마지막으로 QUEUE_READY 를 다시 보낸 시각 (ms)
+static uint8_t queueVersion = 0;         // 대기열 스냅샷 버전 (대기열이 바뀔 때마다 증가)
+static uint8_t snapshotIds[L3_WAITQUEUE_SIZE]; // 스냅샷 인코딩용 대기 사용자 ID (순번 순)
+static uint32_t slotFreedTime = 0;       // 대기자가 있는 상태에서 자리가 빈 시각 (ms)
+static uint8_t isAdmissionPending = 0;   // 자리가 비어 다음 대기자 입장을 기다리는 중 (입장 지연 측정)
+static uint32_t lastOfferTime = 0;       // 마지막으로 다른 부스를 안내한 시각 (ms)
+
+// 시리얼 포트 인터페이스
+static Serial pc(USBTX, USBRX);
+
+// 함수 프로토타입
+static void handleConnectRequest(uint8_t srcId, uint8_t cachedInfoVersion, uint8_t reqId);
+static uint8_t answerFromCache(uint8_t srcId, uint8_t reqType, uint8_t reqId); // 재전송 요청이면 캐시한 응답 전송
+static void sendAndCache(uint8_t srcId, uint8_t reqType, uint8_t reqId, uint8_t *msg, uint8_t size); // 응답 전송 및 캐시
+static uint8_t admitOrHold(uint8_t srcId, uint8_t reqType, uint8_t reqId); // 등록/입장 요청 수락 제어 (지금 처리하면 1)
+static void sendBusy(uint8_t srcId, uint8_t reqType, uint8_t reqId, uint16_t retryMs); // BUSY (retry-after) 응답
+static void decideRegisterRequest(uint8_t srcId, uint8_t reqId); // 등록 판정 및 REGISTER_RESPONSE/QUEUE_INFO 응답
+static void decideJoinRequest(uint8_t srcId, uint8_t reqId);     // 등록 판정 및 JOIN_RESPONSE 응답
+static uint8_t checkUserInList(User_t *list, uint8_t listSize, uint8_t userId);
+static uint8_t checkUserInRegisteredList(uint8_t userId);
+static uint8_t addUserToList(User_t *list, uint8_t *listSize, uint8_t listCapacity, uint8_t userId);
+static void removeUserFromList(User_t *list, uint8_t *count, uint8_t listCapacity, uint8_t userId);
+static void removeUserFromActiveList(uint8_t userId);
+static void L3admin_processKeyboardInput(void);      // 관리자 키보드 입력 처리 함수
+static void startSessionTimer(uint8_t userId);       // 사용자 세션 타이머 시작
+static void checkSessionTimer(void);                 // 관리자 측 세션 타이머 확인
+static void endUserSession(uint8_t userId);          // 사용자 세션 종료 처리
+static void admitNextWaitingUser(void);              // 다음 대기 사용자 입장 알림
+static void scheduleAdmitNextWaitingUser(uint32_t delayMs); // 지연 후 다음 대기 사용자 입장
+static void admitNextWaitingUserDeferred(void);      // 지연 실행용 입장 처리
+static void removeFromWaitingQueue(uint8_t userId);  // 대기 큐에서 사용자 제거
+static void updateAllWaitingUsers(void);             // 모든 대기 사용자에게 순번 업데이트
+static void broadcastQueueSnapshot(void);            // 대기열 스냅샷 방송
+static void collectSnapshotId(uint8_t userId, uint8_t position); // 스냅샷용 대기 사용자 ID 수집
+static void printWaitingUser(uint8_t userId, uint8_t position); // 'w' 명령: 대기 사용자 출력
+static void checkQueueReadyTimeout(void);            // 큐 준비 시간 초과 확인
+static void stopQueueReadyTimer(void);               // 입장 알림 대상/예약 상태 해제
+static void checkAdmissionLead(void);                // 세션 종료가 가까우면 다음 대기자 예약 호출
+static void admitReservedUser(void);                 // 미리 등록한 예약 대상 바로 입장
+static uint8_t touchUser(uint8_t userId);            // 사용자에게서 소식을 들은 시각 기록
+static void checkPresence(void);                     // 오래 소식이 없는 활성/대기 사용자 정리
+static void checkFederation(void);                   // 더 빨리 입장할 수 있는 다른 부스를 대기자에게 안내
+static void printPeer(const L3_fedPeer_t *peer);     // 'f' 명령: 다른 부스 상태 출력
+static void handleQueueReadyTimeout(uint8_t userId); // 큐 준비 시간 초과 처리
+static void broadcastChatToActiveUsers(uint8_t senderId, const char* message); // 채팅 브로드캐스트
+static uint32_t estimateAdmissionMs(uint8_t position); // position 번째 대기자의 예상 입장 시간
+static uint8_t encodeAnnounce(uint8_t *msg);         // 현재 부스 상태로 BOOTH_ANNOUNCE 인코딩
+static uint8_t admitUser(uint8_t srcId, uint8_t *position); // 등록 판정 (REGISTER_REASON_* 반환)
+
+// 수신 메시지 핸들러 (L3_msgHandler 레지스트리에 등록)
+static void L3admin_onChatMessage(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3admin_onBoothScan(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3admin_onUserResponse(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3admin_onQueueLeave(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3admin_onExitRequest(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3admin_onConnectRequest(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3admin_onRegisterRequest(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3admin_onJoinRequest(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3admin_onGroupNack(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3admin_onQueueReadyAck(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3admin_onKeepalive(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3admin_onPeerAnnounce(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3admin_onFedRegister(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+
+// 관리자 초기화: 부스 정보 설정 및 초기 방송
+void L3admin_init(uint8_t id)
+{
+    myId = id;
+
+    myBooth.boothId = id;
+    myBooth.capacity = MAX_BOOTH_CAPACITY; // 최대 수용 인원 설정
+    myBooth.currentCount = 0;              // 현재 부스 이용자 수 초기화
+    L3_waitQueue_init();                   // 부스 대기열 초기화
+    sprintf(myBooth.description, "Booth %d - Pop-up Store Experience", id);
+    infoVersion = L3_msg_infoVersion(myBooth.capacity, myBooth.description);
+
+    // 등록(체험) 기록 초기화
+    L3_registry_init();
+
+    // 부스 그룹 (채팅 중계 / 관리자 메시지 멀티캐스트), 그룹 ID = 부스 ID
+    L3_group_initSender(id);
+
+    // 대기 시간 모델 (실제 세션 길이, 입장 지연)
+    L3_waitModel_init();
+
+    // 부스 간 연합 (다른 부스 상태, 체험 기록)
+    L3_fed_init(id);
+
+    // 재전송 요청용 응답 캐시
+    L3_respCache_init();
+
+    // 요청 종류별 처리량 제한 (스캔, 연결, 등록/입장)
+    L3_admission_init(L3_timer_getMs());
+
+    for (uint8_t i = 0; i < MAX_BOOTH_CAPACITY; i++)
+    {
+        myBooth.activeList[i].sessionStartTime = 0; // 활성 목록 세션 시간 초기화
+    }
+
+    pc.printf("\n=== ADMIN MODE: Booth %d ===\n", id);
+    pc.printf("Booth Description: %s\n", myBooth.description);
+    pc.printf("Max Capacity: %d\n", myBooth.capacity);
+    pc.printf("Session Duration: %d seconds\n", SESSION_DURATION_MS / 1000);
+    pc.printf("\nAdmin Commands:\n");
+    pc.printf("  'm' - Send custom broadcast message\n");
+    pc.printf("  's' - Show booth status\n");
+    pc.printf("  'a' - Send announcement\n");
+    pc.printf("  'q' - Toggle quiet mode (reduce auto broadcasts)\n");
+    pc.printf("  't' - Show session timers\n"); // 세션 타이머 상태 확인
+    pc.printf("  'w' - Show waiting queue\n");  // 대기 큐 상태 확인
+    pc.printf("  'r' - Show message statistics\n"); // 메시지 타입별 처리 통계
+    pc.printf("  'f' - Show other booths\n");     // 부스 간 연합 상태
+    pc.printf("  'h' - Show help\n\n");
+
+    // 키보드 인터럽트 설정: 관리자가 명령 입력 시 처리
+    pc.attach(&L3admin_processKeyboardInput, Serial::RxIrq);
+
+    // 초기 부스 방송 전송 (BROADCAST_ID를 통해 전체 사용자에게)
+    uint8_t announceData[10];
+    uint8_t msgSize = encodeAnnounce(announceData);
+
+    pc.printf("Booth initialized. Waiting for users...\n");
+    pc.printf("Sending initial broadcast...\n");
+    L3_LLI_dataReqFunc(announceData, msgSize, BROADCAST_ID);
+
+    // 자동 방송 간격 (Trickle): 초기 방송이 첫 간격의 방송을 대신함
+    L3_trickle_init(L3_timer_getMs());
+    L3_trickle_hear();
+}
+
+// 관리자 메시지 핸들러 등록: (역할, 상태, 메시지 타입) -> 핸들러
+// 새 메시지 타입은 여기에 한 줄 추가하고 핸들러 함수를 작성하면 됨
+void L3admin_registerHandlers(void)
+{
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_CHAT_MESSAGE,     L3admin_onChatMessage);
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_CHAT_COMPACT,     L3admin_onChatMessage);
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_BOOTH_SCAN,       L3admin_onBoothScan);
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_USER_RESPONSE,    L3admin_onUserResponse);
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_QUEUE_LEAVE,      L3admin_onQueueLeave);
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_EXIT_REQUEST,     L3admin_onExitRequest);
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_CONNECT_REQUEST,  L3admin_onConnectRequest);
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_REGISTER_REQUEST, L3admin_onRegisterRequest);
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_GROUP_NACK,       L3admin_onGroupNack);
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_JOIN_REQUEST,     L3admin_onJoinRequest);
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_QUEUE_READY_ACK,  L3admin_onQueueReadyAck);
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_KEEPALIVE,        L3admin_onKeepalive);
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_BOOTH_ANNOUNCE,   L3admin_onPeerAnnounce);
+    L3_handler_register(L3ROLE_ADMIN, L3STATE_IN_USE,      MSG_TYPE_FED_REGISTER,     L3admin_onFedRegister);
+}
+
+// 관리자는 항상 IN_USE 상태에서 부스 운영
+uint8_t L3admin_getState(void)
+{
+    return L3STATE_IN_USE;
+}
+
+// 관리자 주기 처리: 세션/큐 타이머 확인 및 자동 부스 방송
+void L3admin_run(void)
+{
+    // 관리자 측 세션 타이머 및 대기 큐 타이머 주기적으로 확인
+    sessionTimerCounter++;
+    if (sessionTimerCounter > TIMER_CHECK_INTERVAL)
+    {
+        sessionTimerCounter = 0;
+        checkSessionTimer(); // 활성 사용자 세션 시간 체크
+        checkAdmissionLead(); // 세션 종료 임박 시 다음 대기자 예약 호출
+        checkPresence();      // 사라진 사용자 (무응답) 자리/대기열 정리
+        checkFederation();    // 다른 부스가 훨씬 빠르면 대기자에게 안내
+
+        // 대기 큐 준비 시간 초과 확인
+        if (isQueueReadyTimerActive)
+        {
+            checkQueueReadyTimeout();
+        }
+    }
+
+    // 보류한 등록/입장 요청: 토큰이 차는 대로 도착 순서대로 처리
+    uint8_t heldUserId;
+    uint8_t heldType;
+    uint8_t heldReqId;
+    while (L3_admission_popPending(L3_timer_getMs(), &heldUserId, &heldType, &heldReqId))
+    {
+        pc.printf("\n[Admin] Processing held request from User %d\n", heldUserId);
+        if (heldType == MSG_TYPE_JOIN_REQUEST)
+        {
+            decideJoinRequest(heldUserId, heldReqId);
+        }
+        else
+        {
+            decideRegisterRequest(heldUserId, heldReqId);
+        }
+    }
+
+    // 관리자 자동 부스 방송 (quietMode가 꺼져 있으면)
+    //   - 이용자 수/대기 인원이 바뀌면 곧바로 (L3_ANNOUNCE_IMINMS), 그대로면 간격을 두 배씩 늘림 (L3_ANNOUNCE_IMAXMS 까지)
+    if (!quietMode)
+    { // quietMode가 OFF인 경우
+        uint32_t now = L3_timer_getMs();
+        if (myBooth.currentCount != announcedCount || L3_waitQueue_getCount() != announcedWaiting)
+        {
+            announcedCount = myBooth.currentCount;
+            announcedWaiting = L3_waitQueue_getCount();
+            L3_trickle_reset(now);
+        }
+
+        if (L3_trickle_poll(now))
+        {
+            uint8_t announceData[10];
+            uint8_t msgSize = encodeAnnounce(announceData);
+
+            //pc.printf("\n[Admin] Broadcasting booth info (Users: %d/%d)...\n",
+                      //myBooth.currentCount, myBooth.capacity);
+            L3_LLI_dataReqFunc(announceData, msgSize, BROADCAST_ID);
+
+            // 방송은 ACK 가 없으므로 대기열 스냅샷도 주기적으로 다시 보냄 (같은 버전)
+            broadcastQueueSnapshot();
+        }
+    }
+}
+
+// 채팅 메시지 수신 및 중계 (관리자 측, CHAT_MESSAGE / CHAT_COMPACT)
+//   - 중계할 때 다시 인코딩하므로 압축 여부는 받은 형식과 무관
+static void L3admin_onChatMessage(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    char text[L3_CHAT_MAXLEN + 1];
+    char *chatMsg = (char *)L3_msg_getData(msg);
+    if (L3_msg_getType(msg) == MSG_TYPE_CHAT_COMPACT)
+    {
+        uint8_t senderId;
+        if (!L3_msg_getChatCompact(msg, size, &senderId, text, sizeof(text)))
+        {
+            pc.printf("\n[Admin] Warning: undecodable chat from User %d dropped\n", srcId);
+            return;
+        }
+        chatMsg = text;
+    }
+    pc.printf("\n[CHAT] User %d: %s\n", srcId, chatMsg);
+    touchUser(srcId);
+
+    // 해당 사용자가 activeList에 있는지 확인
+    if (checkUserInList(myBooth.activeList, myBooth.currentCount, srcId))
+    {
+        // 같은 부스의 다른 활성 사용자들에게 브로드캐스트
+        broadcastChatToActiveUsers(srcId, chatMsg);
+    }
+    else
+    {
+        pc.printf("[Admin] Warning: User %d not in active list, chat rejected\n", srcId);
+    }
+}
+
+// 그룹 프레임 재전송 요청 수신 (관리자 측)
+static void L3admin_onGroupNack(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    // 부스 안의 사용자만 그룹 구성원
+    if (!checkUserInList(myBooth.activeList, myBooth.currentCount, srcId))
+    {
+        return;
+    }
+
+    uint8_t nbRepaired = L3_group_repair(srcId, msg, size);
+    debug_if(DBGMSG_L3, "[Admin] Repaired %i group frame(s) for User %i\n", nbRepaired, srcId);
+}
+
+// 부스 스캔 요청 수신 (관리자 측)
+static void L3admin_onBoothScan(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    // 스캔 폭주: 응답하지 않음 (BUSY 도 보내지 않음, 사용자는 다른 부스 응답이나 다음 스캔으로 충분)
+    if (!L3_admission_take(L3_ADMISSION_SCAN, L3_timer_getMs()))
+    {
+        pc.printf("\n[Admin] Busy: scan request from User %d ignored\n", srcId);
+        return;
+    }
+
+    pc.printf("\n[Admin] Received scan request from User %d (RSSI: %d dBm)\n", srcId, rssi);
+
+    // 부스 정보(현재 이용자 수, 정원, 대기 인원) 응답
+    uint8_t announceData[10];
+    uint8_t msgSize = encodeAnnounce(announceData);
+
+    // 구 형식 스캔 (응답 창 없음): 바로 응답
+    if (size < L3_MSG_OFFSET_DATA + L3_SCAN_OFFSET_SLOTLEN + 1)
+    {
+        L3_LLI_dataReqFunc(announceData, msgSize, srcId);
+        pc.printf("[Admin] Sent booth announce to User %d\n", srcId);
+        return;
+    }
+
+    // 방송 스캔: 다른 부스와 겹치지 않도록 응답 창 안의 임의 슬롯에서 응답
+    uint8_t *msgData = L3_msg_getData(msg);
+    uint8_t nbSlots = msgData[L3_SCAN_OFFSET_NBSLOTS];
+    uint32_t slotMs = (uint32_t)msgData[L3_SCAN_OFFSET_SLOTLEN] * L3_SCAN_SLOTUNIT_MS;
+    uint8_t slot = 0;
+    if (nbSlots > 1)
+    {
+        // 노드마다 다르게 시드된 난수로 골라 같은 슬롯 선택을 피함
+        slot = (uint8_t)L2_backoff_randRange(nbSlots);
+    }
+
+    if (L3_deferred_send(announceData, msgSize, srcId, slot * slotMs))
+    {
+        pc.printf("[Admin] Booth announce to User %d scheduled in slot %d/%d\n", srcId, slot, nbSlots);
+    }
+    else
+    {
+        L3_LLI_dataReqFunc(announceData, msgSize, srcId);
+        pc.printf("[Admin] Sent booth announce to User %d\n", srcId);
+    }
+}
+
+// 사용자가 부스 체험 여부 응답 (관리자 측)
+static void L3admin_onUserResponse(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    uint8_t *msgData = L3_msg_getData(msg);
+    uint8_t response = msgData[0];
+
+    pc.printf("\n[Admin] Received USER_RESPONSE from User %d: %s\n", 
+             srcId, response == USER_RESPONSE_YES ? "YES" : "NO");
+
+    if (response == USER_RESPONSE_YES)
+    {
+        pc.printf("[Admin] User %d wants to experience the booth\n", srcId);
+        // 이어서 REGISTER_REQUEST 메시지를 수신할 예정
+    }
+    else
+    {
+        // 사용자가 NO 응답 시 (큐 준비 대상이었으면 대기 큐에서 제거)
+        if (pendingUserId == srcId && isQueueReadyTimerActive)
+        {
+            pc.printf("[Admin] Queue ready response received from User %d\n", srcId);
+            // 큐 준비 타이머 중지
+            stopQueueReadyTimer();
+
+            // 대기 큐에서 제거 및 남은 사용자 업데이트
+            removeFromWaitingQueue(srcId);
+            if (L3_waitQueue_getCount() > 0)
+            {
+                updateAllWaitingUsers();
+            }
+        }
+        pc.printf("\n[Admin] User %d declined booth experience\n", srcId);
+    }
+}
+
+// 사용자가 대기열 탈퇴 요청 (관리자 측)
+static void L3admin_onQueueLeave(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    pc.printf("\n[Admin] User %d leaving waiting queue\n", srcId);
+    L3_admission_cancel(srcId);
+
+    // 입장 알림(예약 포함)을 받은 사용자가 떠나면 다음 대기자에게 넘김
+    if (pendingUserId == srcId && isQueueReadyTimerActive)
+    {
+        stopQueueReadyTimer();
+        scheduleAdmitNextWaitingUser(0);
+    }
+
+    // 대기 큐에서 해당 사용자 제거
+    removeFromWaitingQueue(srcId);
+
+    // 남은 대기 사용자 순번 업데이트
+    updateAllWaitingUsers();
+
+    pc.printf("[Admin] Updated waiting queue. Remaining: %d users\n", L3_waitQueue_getCount());
+}
+
+// 사용자가 부스 퇴장 요청 (관리자 측)
+static void L3admin_onExitRequest(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    pc.printf("\n[Admin] Received exit request from User %d\n", srcId);
+    L3_admission_cancel(srcId);
+
+    // 사용자가 activeList에 있는지 확인
+    if (checkUserInList(myBooth.activeList, myBooth.currentCount, srcId))
+    {
+        // 사용자 세션 종료 처리
+        endUserSession(srcId);
+
+        // EXIT_RESPONSE 전송 (성공)
+        uint8_t exitResp[2];
+        exitResp[0] = MSG_TYPE_EXIT_RESPONSE;
+        exitResp[1] = 1; // 성공
+        L3_LLI_dataReqFunc(exitResp, 2, srcId);
+
+        // 약간의 지연 후 다음 대기 사용자 입장 (메시지 전송 안정성, 블로킹 없음)
+        scheduleAdmitNextWaitingUser(EXIT_RESPONSE_GAP_MS);
+    }
+    else
+    {
+        pc.printf("[Admin] Warning: User %d not in active list\n", srcId);
+    }
+}
+
+// 부스 연결 요청 수신 (관리자 측)
+static void L3admin_onConnectRequest(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    pc.printf("\n[Admin] Received connect request from User %d\n", srcId);
+
+    uint8_t reqId = L3_msg_getReqId(msg, size, L3_CONNECT_OFFSET_REQID);
+    if (answerFromCache(srcId, MSG_TYPE_CONNECT_REQUEST, reqId))
+    {
+        return;
+    }
+
+    // 연결 요청 폭주: 다음 토큰 시각을 알려주고 그때 다시 보내게 함
+    uint32_t now = L3_timer_getMs();
+    if (!L3_admission_take(L3_ADMISSION_CONNECT, now))
+    {
+        uint16_t retryMs = L3_admission_reserve(L3_ADMISSION_CONNECT, now);
+        pc.printf("[Admin] Busy: connect request from User %d deferred by %d ms\n", srcId, retryMs);
+        sendBusy(srcId, MSG_TYPE_CONNECT_REQUEST, reqId, retryMs);
+        return;
+    }
+    pc.printf("[Admin] Processing connection request...\n");
+
+    // 즉시 handleConnectRequest 호출하여 부스 정보 전송 (캐시 버전이 같으면 설명 생략)
+    handleConnectRequest(srcId, L3_msg_getInfoVersion(msg, size, L3_CONNECT_OFFSET_INFOVER), reqId);
+
+    // 전송 확인 로그
+    pc.printf("[Admin] Booth info sent to User %d successfully\n", srcId);
+}
+
+// 등록 판정 및 부스/대기열 반영 (REGISTER_REQUEST, JOIN_REQUEST 공용)
+//   - 반환값은 REGISTER_REASON_*, 대기열에 있으면 *position 에 대기 순번
+static uint8_t admitUser(uint8_t srcId, uint8_t *position)
+{
+    *position = 0;
+
+    // 이미 부스 안에 있는 사용자: 응답이 유실되어 다시 보낸 요청이므로 성공 응답 재전송
+    if (checkUserInList(myBooth.activeList, myBooth.currentCount, srcId))
+    {
+        pc.printf("[Admin] User %d already in booth, re-sending success response\n", srcId);
+        return REGISTER_REASON_SUCCESS;
+    }
+
+    // 이미 등록된 사용자인지 확인 (C2 조건)
+    if (checkUserInRegisteredList(srcId))
+    {
+        // !C2: 이미 등록됨 -> 거부
+        pc.printf("User %d registration rejected - already experienced this booth!\n", srcId);
+        return REGISTER_REASON_ALREADY_USED;
+    }
+
+    // 입장 알림(예약 포함)을 받은 사용자의 자리는 비어 있어도 다른 사용자에게 주지 않음
+    uint8_t isHeld = isQueueReadyTimerActive && pendingUserId != srcId;
+
+    if (srcId == pendingUserId && isQueueReadyTimerActive && myBooth.currentCount >= myBooth.capacity)
+    {
+        // 예약 대상이 자리가 비기 전에 등록 요청: 사전 등록으로 처리하고 맨 앞 순번 유지
+        if (isReservation)
+        {
+            isReservationAcked = 1;
+        }
+        *position = 1;
+        pc.printf("[Admin] Reserved User %d registered early, admitted when the slot frees\n", srcId);
+        return REGISTER_REASON_FULL_WAITING;
+    }
+
+    if (myBooth.currentCount + isHeld >= myBooth.capacity)
+    {
+        // C1: 현재 입장 인원 초과 (만원) -> 대기 큐 등록
+        if (!L3_waitQueue_contains(srcId))
+        {
+            // 대기 큐에 사용자 추가 (C3 만족), 대기열도 가득 차면 거부
+            if (!L3_waitQueue_push(srcId))
+            {
+                pc.printf("User %d registration rejected - waiting queue is full (%d)\n", srcId, L3_waitQueue_getCount());
+                return REGISTER_REASON_QUEUE_FULL;
+            }
+            queueVersion++; // 대기열 내용이 바뀜 (다음 스냅샷 방송에 반영)
+            touchUser(srcId);
+
+            *position = L3_waitQueue_getPosition(srcId);
+            pc.printf("User %d added to waiting queue (position: %d/%d)\n",
+                    srcId, *position, L3_waitQueue_getCount()); //position:대기 순번/총 대기 인원
+        }
+        else
+        {
+            // 대기열에서 사용자 위치 찾아서 다시 알려줌
+            touchUser(srcId);
+            *position = L3_waitQueue_getPosition(srcId);
+            pc.printf("[Admin] User %d already in waiting queue (position: %d/%d), re-sending response\n",
+                    srcId, *position, L3_waitQueue_getCount());
+        }
+        return REGISTER_REASON_FULL_WAITING;
+    }
+
+    // !C1 & C2: 정상 등록 가능 (빈 자리 있음, 등록 목록에 없음)
+    // 대기 큐 준비 중인 사용자인지 확인 후 처리
+    if (pendingUserId == srcId && isQueueReadyTimerActive)
+    {
+        pc.printf("[Admin] Queue ready response received from User %d\n", srcId);
+        // 큐 준비 타이머 중지
+        stopQueueReadyTimer();
+
+        // 대기 큐에서 제거 및 남은 사용자 업데이트
+        removeFromWaitingQueue(srcId);
+        if (L3_waitQueue_getCount() > 0)
+        {
+            updateAllWaitingUsers();
+        }
+    }
+    // 자리가 빈 뒤 대기자가 들어오기까지 걸린 시간 반영 (무응답 건너뛰기 포함)
+    if (isAdmissionPending)
+    {
+        isAdmissionPending = 0;
+        L3_waitModel_addAdmission(L3_timer_getMs() - slotFreedTime);
+    }
+
+    // 레지스트리에 사용자 추가 (체험 기록), 다른 부스에도 알림 (이 부스로는 안내하지 않도록)
+    if (L3_registry_add(srcId, L3_timer_getMs()))
+    {
+        uint8_t fedMsg[2];
+        uint8_t fedMsgSize = L3_msg_encodeFedRegister(fedMsg, srcId);
+        L3_LLI_dataReqFunc(fedMsg, fedMsgSize, BROADCAST_ID);
+    }
+
+    // activeList에 사용자 추가 및 세션 타이머 시작
+    addUserToList(myBooth.activeList, &myBooth.currentCount, MAX_BOOTH_CAPACITY, srcId);
+    startSessionTimer(srcId); // 세션 시작 시간 기록
+
+    pc.printf("User %d successfully registered and entered booth\n", srcId);
+    pc.printf("Session timer started (%d seconds)\n", SESSION_DURATION_MS / 1000);
+    pc.printf("Current booth status: %d/%d users (Total registered: %d)\n",
+              myBooth.currentCount, myBooth.capacity, L3_registry_getCount());
+    return REGISTER_REASON_SUCCESS;
+}
+
+// 사용자 등록 요청 수신 (관리자 측)
+static void L3admin_onRegisterRequest(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    pc.printf("\n[Admin] Received registration request from User %d\n", srcId);
+
+    // 재전송된 요청: 등록 판정과 QUEUE_INFO 를 다시 하지 않음
+    uint8_t reqId = L3_msg_getReqId(msg, size, L3_REGISTER_OFFSET_REQID);
+    if (answerFromCache(srcId, MSG_TYPE_REGISTER_REQUEST, reqId))
+    {
+        return;
+    }
+
+    if (admitOrHold(srcId, MSG_TYPE_REGISTER_REQUEST, reqId))
+    {
+        decideRegisterRequest(srcId, reqId);
+    }
+}
+
+// 등록 판정 후 REGISTER_RESPONSE (대기면 QUEUE_INFO 도) 전송: 바로 또는 보류했던 요청을 꺼내 처리
+static void decideRegisterRequest(uint8_t srcId, uint8_t reqId)
+{
+    debug_if(DBGMSG_L3, "[Admin] Checking registration status of User %i\n", srcId);
+
+    uint8_t response[3];
+    uint8_t position;
+    uint8_t reason = admitUser(srcId, &position);
+
+    // REGISTER_RESPONSE 메시지 먼저 전송
+    uint8_t msgSize = L3_msg_encodeRegisterResponse(response, reason == REGISTER_REASON_SUCCESS, reason);
+    sendAndCache(srcId, MSG_TYPE_REGISTER_REQUEST, reqId, response, msgSize);
+
+    if (reason == REGISTER_REASON_FULL_WAITING)
+    {
+        // QUEUE_INFO 메시지 전송 (대기 순번, 총 대기 인원), 약간의 지연 후 전송되도록 예약
+        uint8_t queueData[5];
+        uint8_t queueMsgSize = L3_msg_encodeQueueInfo(queueData, position, L3_waitQueue_getCount(),
+                                                      L3_waitModel_toSec(estimateAdmissionMs(position)));
+        if (!L3_deferred_send(queueData, queueMsgSize, srcId, QUEUE_INFO_GAP_MS))
+        {
+            pc.printf("[Admin] Warning: deferred queue full, QUEUE_INFO to User %d dropped\n", srcId);
+        }
+    }
+}
+
+// 빠른 입장 요청 수신 (관리자 측): BOOTH_INFO / USER_RESPONSE 없이 바로 등록 판정
+//   - 결과(입장, 대기 순번, 이미 체험함, 대기열 가득 참)를 JOIN_RESPONSE 하나로 응답
+static void L3admin_onJoinRequest(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    pc.printf("\n[Admin] Received join request from User %d\n", srcId);
+
+    uint8_t reqId = L3_msg_getReqId(msg, size, L3_JOINREQ_OFFSET_REQID);
+    if (answerFromCache(srcId, MSG_TYPE_JOIN_REQUEST, reqId))
+    {
+        return;
+    }
+
+    if (admitOrHold(srcId, MSG_TYPE_JOIN_REQUEST, reqId))
+    {
+        decideJoinRequest(srcId, reqId);
+    }
+}
+
+// 등록 판정 후 JOIN_RESPONSE 전송: 바로 또는 보류했던 요청을 꺼내 처리
+static void decideJoinRequest(uint8_t srcId, uint8_t reqId)
+{
+    uint8_t position;
+    uint8_t reason = admitUser(srcId, &position);
+    uint16_t etaSec = L3_ETA_UNKNOWN;
+    if (reason == REGISTER_REASON_FULL_WAITING)
+    {
+        etaSec = L3_waitModel_toSec(estimateAdmissionMs(position));
+    }
+
+    uint8_t response[8];
+    uint8_t msgSize = L3_msg_encodeJoinResponse(response, reason, position, L3_waitQueue_getCount(), etaSec);
+    sendAndCache(srcId, MSG_TYPE_JOIN_REQUEST, reqId, response, msgSize);
+}
+
+// Start session timer for a user (관리자 측)
+static void startSessionTimer(uint8_t userId)
+{
+    // 활성 사용자 목록에서 해당 사용자 찾아 세션 시작 시각 기록
+    for (uint8_t i = 0; i < myBooth.currentCount; i++)
+    {
+        if (myBooth.activeList[i].userId == userId)
+        {
+            myBooth.activeList[i].sessionStartTime = L3_timer_getMs(); // ms 단위 저장
+            myBooth.activeList[i].lastSeenTime = L3_timer_getMs();
+            pc.printf("[Admin] Session timer started for User %d\n", userId);
+            break;
+        }
+    }
+}
+
+// 모든 활성 사용자에 대한 세션 타이머 확인 (관리자 측)
+static void checkSessionTimer(void)
+{
+    uint32_t currentTime = L3_timer_getMs(); // ms 단위
+
+    for (uint8_t i = 0; i < myBooth.currentCount; i++)
+    {
+        uint32_t sessionTime = currentTime - myBooth.activeList[i].sessionStartTime;
+
+        if (sessionTime >= SESSION_DURATION_MS)
+        {
+            uint8_t userId = myBooth.activeList[i].userId;
+            pc.printf("\n[Admin] Session timeout for User %d!\n", userId);
+
+            // TIMEOUT_ALERT 메시지 전송 (사용자 세션 만료)
+            uint8_t timeoutMsg[2];
+            timeoutMsg[0] = MSG_TYPE_TIMEOUT_ALERT;
+            timeoutMsg[1] = 0; // 예약 필드
+            L3_LLI_dataReqFunc(timeoutMsg, 2, userId);
+
+            // 사용자 세션 종료 처리
+            endUserSession(userId);
+
+            // 약간의 지연 후 다음 대기 사용자 입장 (메시지 전송 안정성, 블로킹 없음)
+            scheduleAdmitNextWaitingUser(EXIT_DELAY_MS);
+
+            // 배열이 변경되었으므로 루프 재시작
+            break;
+        }
+    }
+}
+
+// 사용자 세션 종료 처리 (관리자 측, activeList에서만 제거)
+static void endUserSession(uint8_t userId)
+{
+    // 활성 목록에서 사용자 찾아 세션 지속 시간 계산 (로그용)
+    for (uint8_t i = 0; i < myBooth.currentCount; i++)
+    {
+        if (myBooth.activeList[i].userId == userId)
+        {
+            uint32_t sessionDuration = L3_timer_getMs() - myBooth.activeList[i].sessionStartTime;
+            pc.printf("[Admin] User %d session ended. Duration: %d seconds\n",
+                      userId, sessionDuration / 1000);
+
+            // 실제 세션 길이 반영 (조기 퇴장 포함)
+            L3_waitModel_addSession(sessionDuration);
+            pc.printf("[Admin] Average session: %d sec, admission latency: %d ms\n",
+                      L3_waitModel_getSessionMs() / 1000, L3_waitModel_getAdmissionMs());
+
+            // 기다리는 사람이 있으면 입장 지연 측정 시작
+            if (!isAdmissionPending && (L3_waitQueue_getCount() > 0 || isQueueReadyTimerActive))
+            {
+                isAdmissionPending = 1;
+                slotFreedTime = L3_timer_getMs();
+            }
+            break;
+        }
+    }
+
+    // 활성 목록에서 사용자 제거 (등록 목록은 유지)
+    removeUserFromActiveList(userId);
+
+    pc.printf("[Admin] User %d has exited. Current users: %d/%d\n",
+              userId, myBooth.currentCount, myBooth.capacity);
+}
+
+// 다음 대기 사용자 입장 처리 (풀 기반 구현, 관리자 측)
+// 다음 대기 사용자 입장을 delayMs 후로 예약 (예약 실패 시 즉시 처리)
+//   - 미리 등록한 예약 대상이 있으면 간격 없이 바로 입장
+static void scheduleAdmitNextWaitingUser(uint32_t delayMs)
+{
+    if (isReservationAcked)
+    {
+        delayMs = 0;
+    }
+
+    if (!L3_deferred_call(admitNextWaitingUserDeferred, delayMs))
+    {
+        admitNextWaitingUser();
+    }
+}
+
+// 예약된 입장 처리: 그 사이 자리가 다시 찼으면 건너뜀
+static void admitNextWaitingUserDeferred(void)
+{
+    if (myBooth.currentCount < myBooth.capacity)
+    {
+        admitNextWaitingUser();
+    }
+}
+
+// 다음 대기 사용자 입장 알림
+//   - 자리가 있으면 바로 입장 알림, 만원이면 세션 종료 임박 시에만 예약 호출 (남은 시간 포함)
+static void admitNextWaitingUser(void)
+{
+    // 예약 대상이 이미 미리 등록했으면 빈 자리에 바로 입장
+    if (isQueueReadyTimerActive && isReservationAcked)
+    {
+        if (myBooth.currentCount < myBooth.capacity)
+        {
+            admitReservedUser();
+        }
+        return;
+    }
+
+    if (L3_waitQueue_getCount() > 0 && !isQueueReadyTimerActive)
+    {
+        uint32_t leadMs = 0;
+        if (myBooth.currentCount >= myBooth.capacity)
+        {
+            // 만원: 가장 먼저 끝나는 세션의 남은 시간이 리드 타임 안일 때만 예약
+            uint32_t currentTime = L3_timer_getMs();
+            leadMs = SESSION_DURATION_MS;
+            for (uint8_t i = 0; i < myBooth.currentCount; i++)
+            {
+                uint32_t elapsed = currentTime - myBooth.activeList[i].sessionStartTime;
+                uint32_t remaining = (elapsed < SESSION_DURATION_MS) ? SESSION_DURATION_MS - elapsed : 0;
+                if (remaining < leadMs)
+                {
+                    leadMs = remaining;
+                }
+            }
+            if (ADMISSION_LEAD_MS == 0 || leadMs > ADMISSION_LEAD_MS)
+            {
+                return;
+            }
+        }
+
+        // 대기 큐의 첫 번째 사용자를 꺼냄 (FIFO)
+        uint8_t nextUserId = L3_waitQueue_pop();
+
+        pc.printf("\n[Admin] Preparing to notify User %d (waiting queue position 1)\n", nextUserId);
+        pc.printf("[Admin] Remaining waiting queue size: %d\n", L3_waitQueue_getCount());
+
+        // QUEUE_READY 메시지 전송: 차례가 된 사용자에게 입장 알림 (예약이면 자리가 빌 때까지 남은 초, 최소 1)
+        uint8_t readyMsg[2];
+        uint8_t leadSec = 0;
+        if (myBooth.currentCount >= myBooth.capacity)
+        {
+            leadSec = (leadMs / 1000 > 0) ? leadMs / 1000 : 1;
+        }
+        uint8_t msgSize = L3_msg_encodeQueueReady(readyMsg, leadSec);
+
+        if (leadSec > 0)
+        {
+            pc.printf("[Admin] Sending QUEUE_READY reservation to User %d (slot frees in %d sec)\n", nextUserId, leadSec);
+        }
+        else
+        {
+            pc.printf("[Admin] Sending QUEUE_READY (0x%02X) to User %d\n", MSG_TYPE_QUEUE_READY, nextUserId);
+        }
+        L3_LLI_dataReqFunc(readyMsg, msgSize, nextUserId);
+
+        // 큐 준비 타이머 시작: 일정 시간 안에 응답이 없으면 제거
+        pendingUserId = nextUserId;
+        queueReadyStartTime = L3_timer_getMs(); // ms 단위 저장
+        isQueueReadyTimerActive = 1;
+        isReservation = (leadSec > 0);
+        isReservationAcked = 0;
+        queueReadyTimeoutMs = QUEUE_READY_TIMEOUT_MS;
+        isPresenceProbing = 0;
+
+        pc.printf("[Admin] Queue ready timer started for User %d (%d seconds timeout)\n",
+                  nextUserId, QUEUE_READY_TIMEOUT_MS / 1000);
+    }
+    else
+    {
+        pc.printf("[Admin] No users in waiting queue to admit\n");
+    }
+}
+
+// 대기열에서 사용자 제거 (관리자 측)
+static void removeFromWaitingQueue(uint8_t userId)
+{
+    if (L3_waitQueue_remove(userId))
+    {
+        pc.printf("[Admin] User %d removed from waiting queue. New waiting count: %d\n", userId, L3_waitQueue_getCount());
+    }
+}
+
+// 모든 대기 사용자에게 새 순번 업데이트 (관리자 측)
+//   - 사용자별 유니캐스트 대신 새 버전의 스냅샷을 한 번 방송, 각 사용자가 자기 순번을 계산
+static void updateAllWaitingUsers(void)
+{
+    queueVersion++;
+    broadcastQueueSnapshot();
+}
+
+// 현재 대기열을 QUEUE_SNAPSHOT 으로 방송 (L2 프레임 하나씩 들어가는 세그먼트로 나눔)
+static void broadcastQueueSnapshot(void)
+{
+    uint8_t total = L3_waitQueue_getCount();
+    if (total == 0)
+    {
+        return;
+    }
+
+    L3_waitQueue_forEach(collectSnapshotId);
+
+    uint8_t offset = 0;
+    while (offset < total)
+    {
+        uint8_t snapshotMsg[L3_SNAPSHOT_MAXSIZE];
+        uint8_t nbEncoded;
+        uint8_t msgSize = L3_msg_encodeQueueSnapshot(snapshotMsg, queueVersion, total, offset + 1,
+                                                     &snapshotIds[offset], total - offset, &nbEncoded);
+        if (!L3_LLI_dataReqFunc(snapshotMsg, msgSize, BROADCAST_ID))
+        {
+            // 방송은 ACK 가 없음: 다음 주기 방송 (같은 버전) 에서 다시 보냄
+            pc.printf("[Admin] Warning: TX queue full, queue snapshot v%d cut at %d/%d\n", queueVersion, offset, total);
+            return;
+        }
+        offset += nbEncoded;
+    }
+
+    pc.printf("[Admin] Queue snapshot v%d broadcast (%d waiting)\n", queueVersion, total);
+}
+
+static void collectSnapshotId(uint8_t userId, uint8_t position)
+{
+    snapshotIds[position - 1] = userId;
+}
+
+// 'w' 명령: 대기 사용자 한 명 출력
+static void printWaitingUser(uint8_t userId, uint8_t position)
+{
+    pc.printf("  %d. User %d", position, userId);
+    if (position == 1 && isQueueReadyTimerActive)
+    {
+        uint32_t elapsed = (L3_timer_getMs() - queueReadyStartTime) / 1000;
+        uint32_t remaining = (elapsed < queueReadyTimeoutMs / 1000) ? (queueReadyTimeoutMs / 1000) - elapsed : 0;
+        pc.printf(" (Notified - %d sec remaining)", remaining);
+    }
+    pc.printf("\n");
+}
+
+// Check queue ready timeout (관리자 측)
+static void checkQueueReadyTimeout(void)
+{
+    // 미리 등록한 예약 대상은 자리가 빌 때까지 기다림 (시간 초과 없음)
+    if (isQueueReadyTimerActive && !isReservationAcked)
+    {
+        uint32_t currentTime = L3_timer_getMs();
+        uint32_t elapsedTime = currentTime - queueReadyStartTime;
+
+        if (elapsedTime >= queueReadyTimeoutMs)
+        {
+            handleQueueReadyTimeout(pendingUserId); // 시간 초과 처리 함수 호출
+        }
+        else if (isPresenceProbing && currentTime - lastProbeTime >= L3_PRESENCE_PROBEMS)
+        {
+            // 멀리 있는 사용자: 다시 호출해 사용자 측이 새 RSSI 로 근접 여부를 판단하게 함
+            uint8_t readyMsg[2];
+            uint8_t msgSize = L3_msg_encodeQueueReady(readyMsg, 0);
+            L3_LLI_dataReqFunc(readyMsg, msgSize, pendingUserId);
+            lastProbeTime = currentTime;
+        }
+    }
+}
+
+// Handle queue ready timeout (관리자 측)
+static void handleQueueReadyTimeout(uint8_t userId)
+{
+    pc.printf("\n[Admin] User %d did not respond in time. Moving to next...\n", userId);
+
+    // 타이머 중지
+    stopQueueReadyTimer();
+
+    // 해당 사용자에게 대기열에서 제거 알림 전송: 위치=0, 총 대기=0
+    uint8_t removalMsg[3];
+    removalMsg[0] = MSG_TYPE_QUEUE_UPDATE;
+    removalMsg[1] = 0; // 순번 0 = 제거됨 표시
+    removalMsg[2] = 0; // 총 대기 인원 0 = 제거됨 표시
+    L3_LLI_dataReqFunc(removalMsg, 3, userId);
+
+    // 대기 큐에서 사용자 제거
+    removeFromWaitingQueue(userId);
+
+    // 남은 대기 사용자 순번 업데이트
+    if (L3_waitQueue_getCount() > 0)
+    {
+        updateAllWaitingUsers();
+    }
+
+    // 다음 대기 사용자 입장 시도
+    admitNextWaitingUser();
+}
+
+// 입장 알림 대상/예약 상태 해제 (큐 준비 타이머 중지)
+static void stopQueueReadyTimer(void)
+{
+    isQueueReadyTimerActive = 0;
+    pendingUserId = 0;
+    isReservation = 0;
+    isReservationAcked = 0;
+    isPresenceProbing = 0;
+}
+
+// 파이프라인 입장: 세션 종료가 ADMISSION_LEAD_MS 안으로 다가오면 다음 대기자를 미리 예약 호출
+//   - 자리가 비는 순간 QUEUE_READY / REGISTER 왕복 없이 바로 입장 처리됨
+static void checkAdmissionLead(void)
+{
+    if (ADMISSION_LEAD_MS == 0 || isQueueReadyTimerActive || L3_waitQueue_getCount() == 0 ||
+        myBooth.currentCount < myBooth.capacity)
+    {
+        return;
+    }
+
+    admitNextWaitingUser(); // 리드 타임 밖이면 아무것도 보내지 않음
+}
+
+// 미리 등록한 예약 대상 입장: 일반 등록과 같은 판정 후 REGISTER_RESPONSE 로 알림
+static void admitReservedUser(void)
+{
+    uint8_t userId = pendingUserId;
+    uint8_t position;
+
+    pc.printf("\n[Admin] Slot freed, admitting reserved User %d\n", userId);
+    uint8_t reason = admitUser(userId, &position); // 예약 상태도 여기서 해제됨
+
+    uint8_t response[3];
+    uint8_t msgSize = L3_msg_encodeRegisterResponse(response, reason == REGISTER_REASON_SUCCESS, reason);
+    L3_LLI_dataReqFunc(response, msgSize, userId);
+}
+
+// 입장 알림 응답 (관리자 측)
+//   - 예약 호출이면 사전 등록
+//   - 바로 입장 호출이면 사용자가 아직 멀리 있음: 제한 시간을 줄이고 다시 호출하며 근접 확인(REGISTER_REQUEST)을 기다림
+static void L3admin_onQueueReadyAck(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    if (srcId != pendingUserId || !isQueueReadyTimerActive)
+    {
+        return;
+    }
+
+    if (!isReservation)
+    {
+        if (!isPresenceProbing)
+        {
+            int8_t userRssi = (size > L3_MSG_OFFSET_DATA + L3_READYACK_OFFSET_RSSI) ?
+                              (int8_t)L3_msg_getData(msg)[L3_READYACK_OFFSET_RSSI] : (int8_t)rssi;
+            uint32_t currentTime = L3_timer_getMs();
+            uint32_t farDeadline = (currentTime - queueReadyStartTime) + L3_PRESENCE_FARWAITMS;
+
+            isPresenceProbing = 1;
+            lastProbeTime = currentTime;
+            if (farDeadline < queueReadyTimeoutMs)
+            {
+                queueReadyTimeoutMs = farDeadline;
+            }
+            pc.printf("\n[Admin] User %d is not near the booth yet (%d dBm), waiting %d ms\n",
+                      srcId, userRssi, L3_PRESENCE_FARWAITMS);
+        }
+        return;
+    }
+
+    pc.printf("\n[Admin] User %d pre-registered for the next free slot\n", srcId);
+    isReservationAcked = 1;
+
+    // 그 사이 자리가 이미 비었으면 바로 입장
+    if (myBooth.currentCount < myBooth.capacity)
+    {
+        admitReservedUser();
+    }
+}
+
+// 사용자에게서 소식을 들은 시각 기록: 활성 목록 또는 대기열에 있으면 1
+static uint8_t touchUser(uint8_t userId)
+{
+    uint32_t now = L3_timer_getMs();
+
+    for (uint8_t i = 0; i < myBooth.currentCount; i++)
+    {
+        if (myBooth.activeList[i].userId == userId)
+        {
+            myBooth.activeList[i].lastSeenTime = now;
+            return 1;
+        }
+    }
+    return L3_waitQueue_touch(userId, now);
+}
+
+// 사라진 사용자 정리: L3_PRESENCE_SILENCEMS 동안 KEEPALIVE 도 다른 메시지도 없으면 자리/순번 반납
+//   - 세션 만료(SESSION_DURATION_MS)를 기다리지 않고 다음 대기자가 들어올 수 있게 함
+static void checkPresence(void)
+{
+    if (L3_PRESENCE_SILENCEMS == 0)
+    {
+        return;
+    }
+
+    uint32_t now = L3_timer_getMs();
+
+    for (uint8_t i = 0; i < myBooth.currentCount; i++)
+    {
+        if (now - myBooth.activeList[i].lastSeenTime >= L3_PRESENCE_SILENCEMS)
+        {
+            uint8_t userId = myBooth.activeList[i].userId;
+            pc.printf("\n[Admin] User %d silent for %d sec, releasing booth slot\n", userId, L3_PRESENCE_SILENCEMS / 1000);
+
+            endUserSession(userId);
+            scheduleAdmitNextWaitingUser(0);
+            break; // 배열이 바뀜, 나머지는 다음 확인 때 처리
+        }
+    }
+
+    uint8_t nbRemoved = 0;
+    uint8_t userId;
+    while ((userId = L3_waitQueue_findSilent(now, L3_PRESENCE_SILENCEMS)) != 0)
+    {
+        pc.printf("\n[Admin] Waiting User %d silent for %d sec, removing from queue\n", userId, L3_PRESENCE_SILENCEMS / 1000);
+        removeFromWaitingQueue(userId);
+        nbRemoved++;
+    }
+    if (nbRemoved > 0)
+    {
+        updateAllWaitingUsers();
+    }
+}
+
+// 사용자 생존 알림 수신 (관리자 측)
+//   - 이미 정리된 사용자가 돌아온 경우 상태에 맞는 종료 알림을 보내 스캔으로 돌려보냄
+static void L3admin_onKeepalive(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    if (touchUser(srcId) || (srcId == pendingUserId && isQueueReadyTimerActive))
+    {
+        return;
+    }
+
+    uint8_t state = (size > L3_MSG_OFFSET_DATA + L3_KEEPALIVE_OFFSET_STATE) ?
+                    L3_msg_getData(msg)[L3_KEEPALIVE_OFFSET_STATE] : L3STATE_NB;
+    if (state == L3STATE_IN_USE)
+    {
+        pc.printf("[Admin] Keepalive from released User %d, sending timeout alert\n", srcId);
+        uint8_t timeoutMsg[2];
+        timeoutMsg[0] = MSG_TYPE_TIMEOUT_ALERT;
+        timeoutMsg[1] = 0; // 예약 필드
+        L3_LLI_dataReqFunc(timeoutMsg, 2, srcId);
+    }
+    else if (state == L3STATE_WAITING)
+    {
+        pc.printf("[Admin] Keepalive from removed User %d, sending queue removal\n", srcId);
+        uint8_t removalMsg[3];
+        removalMsg[0] = MSG_TYPE_QUEUE_UPDATE;
+        removalMsg[1] = 0; // 순번 0 = 제거됨 표시
+        removalMsg[2] = 0; // 총 대기 인원 0 = 제거됨 표시
+        L3_LLI_dataReqFunc(removalMsg, 3, srcId);
+    }
+}
+
+// 다른 부스의 방송 수신 (관리자 측): 부스 간 연합 상태 갱신
+static void L3admin_onPeerAnnounce(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    if (srcId < ADMIN_ID_START || srcId > ADMIN_ID_END || srcId == myId)
+    {
+        return;
+    }
+
+    uint8_t *msgData = L3_msg_getData(msg);
+    L3_fed_updatePeer(srcId, msgData[1], msgData[2], msgData[3],
+                      L3_msg_getEta(msg, size, L3_ANNOUNCE_OFFSET_ETA), L3_timer_getMs());
+}
+
+// 다른 부스의 체험 기록 수신 (관리자 측)
+static void L3admin_onFedRegister(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    if (srcId < ADMIN_ID_START || srcId > ADMIN_ID_END || srcId == myId ||
+        size <= L3_MSG_OFFSET_DATA + L3_FEDREG_OFFSET_USER)
+    {
+        return;
+    }
+
+    L3_fed_addRegistration(srcId, L3_msg_getData(msg)[L3_FEDREG_OFFSET_USER]);
+}
+
+// 부스 간 부하 분산: 대기자가 다른 부스에서 L3_FED_GAINSEC 이상 빨리 입장할 수 있으면 REDIRECT_OFFER
+//   - 뒤에서부터 확인 (가장 오래 기다리는 사용자가 옮겨서 얻는 시간이 가장 큼)
+//   - L3_FED_OFFERMS 마다 최대 한 명, 사용자당 한 번, 같은 부스로는 다음 방송까지 한 명만
+static void checkFederation(void)
+{
+    uint8_t total = L3_waitQueue_getCount();
+    uint32_t now = L3_timer_getMs();
+    if (L3_FED_GAINSEC == 0 || total == 0 || now - lastOfferTime < L3_FED_OFFERMS)
+    {
+        return;
+    }
+
+    L3_waitQueue_forEach(collectSnapshotId);
+
+    for (uint8_t position = total; position > 0; position--)
+    {
+        uint8_t userId = snapshotIds[position - 1];
+        if (L3_fed_wasOffered(userId))
+        {
+            continue;
+        }
+
+        const L3_fedPeer_t *peer = L3_fed_findBestPeer(userId, now, L3_FED_MAXAGEMS);
+        if (peer == NULL)
+        {
+            continue;
+        }
+
+        uint16_t myEtaSec = L3_waitModel_toSec(estimateAdmissionMs(position));
+        if ((uint32_t)myEtaSec < (uint32_t)peer->etaSec + L3_FED_GAINSEC)
+        {
+            continue;
+        }
+
+        pc.printf("\n[Admin] Offering Booth %d to waiting User %d (ETA %d sec there, %d sec here)\n",
+                  peer->boothId, userId, peer->etaSec, myEtaSec);
+
+        uint8_t offerMsg[5];
+        uint8_t msgSize = L3_msg_encodeRedirectOffer(offerMsg, peer->boothId, peer->etaSec);
+        L3_LLI_dataReqFunc(offerMsg, msgSize, userId);
+
+        L3_fed_markOffered(peer->boothId, userId);
+        lastOfferTime = now;
+        return;
+    }
+}
+
+// 'f' 명령: 다른 부스 하나 출력
+static void printPeer(const L3_fedPeer_t *peer)
+{
+    if (peer->boothId == 0)
+    {
+        return;
+    }
+
+    pc.printf("  Booth %d: %d/%d users, %d waiting", peer->boothId, peer->currentCount, peer->capacity, peer->waitingCount);
+    if (peer->etaSec != L3_ETA_UNKNOWN)
+    {
+        pc.printf(", ETA %d sec", peer->etaSec);
+    }
+    pc.printf(" (heard %d sec ago)\n", (L3_timer_getMs() - peer->lastHeardTime) / 1000);
+}
+
+// position 번째 대기자 (1부터) 의 예상 입장 시간 (ms)
+//   - 입장 알림을 받고 아직 등록하지 않은 사용자는 대기열에서 빠졌지만 자리를 먼저 차지함
+static uint32_t estimateAdmissionMs(uint8_t position)
+{
+    uint32_t elapsedMs[MAX_BOOTH_CAPACITY];
+    uint32_t currentTime = L3_timer_getMs();
+
+    for (uint8_t i = 0; i < myBooth.currentCount; i++)
+    {
+        elapsedMs[i] = currentTime - myBooth.activeList[i].sessionStartTime;
+    }
+
+    if (isQueueReadyTimerActive)
+    {
+        position++;
+    }
+
+    return L3_waitModel_estimateMs(position, elapsedMs, myBooth.currentCount, myBooth.capacity);
+}
+
+// 현재 부스 상태로 BOOTH_ANNOUNCE 인코딩 (예상 시간은 지금 합류하는 사용자 기준)
+static uint8_t encodeAnnounce(uint8_t *msg)
+{
+    uint16_t etaSec = 0;
+    if (myBooth.currentCount >= myBooth.capacity || L3_waitQueue_getCount() > 0 || isQueueReadyTimerActive)
+    {
+        etaSec = L3_waitModel_toSec(estimateAdmissionMs(L3_waitQueue_getCount() + 1));
+    }
+
+    return L3_msg_encodeBoothAnnounce(msg, myBooth.boothId, myBooth.currentCount, myBooth.capacity,
+                                      L3_waitQueue_getCount(), etaSec, infoVersion);
+}
+
+// 채팅 메시지를 같은 부스의 활성 사용자들에게 브로드캐스트
+static void broadcastChatToActiveUsers(uint8_t senderId, const char* message)
+{
+    uint8_t chatMsg[110];
+    uint8_t msgSize = L3_msg_encodeChatMessageWithSender(chatMsg, senderId, message);
+
+    // 부스 그룹에 한 번만 방송 (발신자는 자신의 ID 를 보고 표시하지 않음)
+    if (L3_group_send(chatMsg, msgSize))
+    {
+        pc.printf("[Admin] Forwarded chat to booth group (%d user(s))\n", myBooth.currentCount);
+    }
+    else
+    {
+        pc.printf("[Admin] Warning: chat from User %d could not be forwarded\n", senderId);
+    }
+}
+
+static void handleConnectRequest(uint8_t srcId, uint8_t cachedInfoVersion, uint8_t reqId)
+{
+    uint8_t infoData[60];
+    uint8_t msgSize;
+
+    if (cachedInfoVersion == infoVersion)
+    {
+        // 사용자가 최신 설명을 캐시하고 있음: 현재 사용자 수, 정원, 대기 인원만 전송 (L2 조각 1개)
+        msgSize = L3_msg_encodeBoothInfoShort(infoData, myBooth.currentCount, myBooth.capacity,
+                                              L3_waitQueue_getCount(), infoVersion);
+        pc.printf("[Admin] Sending short booth info to user %d (cached description)\n", srcId);
+    }
+    else
+    {
+        // 부스 정보 전송: 현재 사용자 수, 정원, 대기 인원, 설명, 정보 버전 포함
+        msgSize = L3_msg_encodeBoothInfo(infoData, myBooth.currentCount, myBooth.capacity,
+                                         L3_waitQueue_getCount(), myBooth.description, infoVersion);
+        pc.printf("[Admin] Sending booth info to user %d\n", srcId);
+    }
+
+    sendAndCache(srcId, MSG_TYPE_CONNECT_REQUEST, reqId, infoData, msgSize); // 부스 정보 송신
+}
+
+// 같은 요청 ID 로 다시 온 요청이면 캐시한 응답만 다시 보내고 1 반환 (핸들러 재실행 없음)
+static uint8_t answerFromCache(uint8_t srcId, uint8_t reqType, uint8_t reqId)
+{
+    if (reqId == L3_REQID_NONE)
+    {
+        return 0;
+    }
+
+    uint8_t size;
+    const uint8_t *cached = L3_respCache_find(srcId, reqType, reqId, L3_timer_getMs(), L3_RESPCACHE_MS, &size);
+    if (cached == NULL)
+    {
+        return 0;
+    }
+
+    uint8_t response[L3_RESPCACHE_MSGSIZE];
+    memcpy(response, cached, size);
+    pc.printf("[Admin] Retried request %d from User %d, re-sending cached response\n", reqId, srcId);
+    L3_LLI_dataReqFunc(response, size, srcId);
+    return 1;
+}
+
+// 응답 전송, 요청 ID 가 있으면 재전송 대비로 캐시
+static void sendAndCache(uint8_t srcId, uint8_t reqType, uint8_t reqId, uint8_t *msg, uint8_t size)
+{
+    L3_LLI_dataReqFunc(msg, size, srcId);
+    if (reqId != L3_REQID_NONE)
+    {
+        L3_respCache_store(srcId, reqType, reqId, msg, size, L3_timer_getMs());
+    }
+}
+
+// 등록/입장 요청 수락 제어: 토큰이 있거나 입장 알림을 받은 사용자면 1 (바로 처리)
+//   - 토큰이 없으면 보류 큐에 넣고 처리 예상 시간 + 여유를 BUSY 로 알림 (그 전에 응답이 오면 사용자는 다시 보내지 않음)
+//   - 이미 보류 중인 요청의 재전송이면 새로 넣지 않고 남은 시간만 다시 알림
+//   - 보류 큐도 가득 차면 보류 요청이 다 처리된 뒤의 토큰 시각을 예약해 알림
+static uint8_t admitOrHold(uint8_t srcId, uint8_t reqType, uint8_t reqId)
+{
+    // 입장 알림을 받은 사용자의 등록은 제한하지 않음 (폭주와 무관, 보류하면 입장 알림 시간 초과)
+    if (isQueueReadyTimerActive && srcId == pendingUserId)
+    {
+        return 1;
+    }
+
+    uint32_t now = L3_timer_getMs();
+    uint8_t position = L3_admission_findPending(srcId, reqType, reqId);
+    if (position == 0)
+    {
+        if (L3_admission_take(L3_ADMISSION_JOIN, now))
+        {
+            return 1;
+        }
+        position = L3_admission_enqueue(srcId, reqType, reqId);
+    }
+
+    uint16_t retryMs;
+    if (position == 0)
+    {
+        retryMs = L3_admission_reserve(L3_ADMISSION_JOIN, now);
+        pc.printf("[Admin] Busy: request from User %d refused, retry in %d ms\n", srcId, retryMs);
+    }
+    else
+    {
+        retryMs = L3_admission_pendingMs(position, now) + L3_ADMISSION_MARGINMS;
+        pc.printf("[Admin] Busy: request from User %d held (%d/%d)\n", srcId, position, L3_admission_getPendingCount());
+    }
+
+    sendBusy(srcId, reqType, reqId, retryMs);
+    return 0;
+}
+
+static void sendBusy(uint8_t srcId, uint8_t reqType, uint8_t reqId, uint16_t retryMs)
+{
+    uint8_t busyMsg[5];
+    uint8_t msgSize = L3_msg_encodeBusy(busyMsg, reqType, reqId, retryMs);
+    L3_LLI_dataReqFunc(busyMsg, msgSize, srcId);
+}
+
+static uint8_t checkUserInList(User_t *list, uint8_t listSize, uint8_t userId)
+{
+    // 주어진 리스트(list)에서 userId 존재 여부 확인
+    for (uint8_t i = 0; i < listSize; i++)
+    {
+        if (list[i].userId == userId)
+        {
+            return 1; // 리스트에 있음
+        }
+    }
+    return 0; // 리스트에 없음
+}
+
+// list 는 listCapacity 칸짜리 배열 (가득 차면 0 반환)
+static uint8_t addUserToList(User_t *list, uint8_t *count, uint8_t listCapacity, uint8_t userId)
+{
+    // Admin은 리스트에 추가하지 않음
+    if (userId <= 3)  // Admin ID가 3 이하
+    {
+        return 1; // Admin은 성공으로 처리하지만 리스트에 추가하지 않음
+    }
+    
+    // 리스트에 이미 있는지 중복 확인
+    for (uint8_t i = 0; i < *count; i++)
+    {
+        if (list[i].userId == userId)
+        {
+            return 1; // 이미 리스트에 있음
+        }
+    }
+
+    // 새 사용자 추가 (리스트가 가득 차지 않았다면)
+    if (*count < listCapacity)
+    {
+        list[*count].userId = userId;
+        list[*count].isActive = 1;
+        (*count)++;
+        return 1;
+    }
+    return 0;
+}
+
+static void removeUserFromList(User_t *list, uint8_t *count, uint8_t listCapacity, uint8_t userId)
+{
+    // 리스트(list)에서 userId 제거 (배열 크기 listCapacity 밖은 보지 않음)
+    for (uint8_t i = 0; i < *count && i < listCapacity; i++)
+    {
+        if (list[i].userId == userId)
+        {
+            // 뒤의 요소들을 앞으로 한 칸씩 이동
+            for (uint8_t j = i; j + 1 < *count && j + 1 < listCapacity; j++)
+            {
+                list[j] = list[j + 1];
+            }
+            (*count)--;
+            break;
+        }
+    }
+}
+
+// 사용자가 registered list에 있는지 확인
+static uint8_t checkUserInRegisteredList(uint8_t userId)
+{
+    if (L3_registry_contains(userId))
+    {
+        debug_if(DBGMSG_L3, "[Admin] User %i found in registered list\n", userId);
+        return 1;
+    }
+    debug_if(DBGMSG_L3, "[Admin] User %i not found in registered list (count: %i)\n", userId, L3_registry_getCount());
+    return 0;
+}
+
+// 사용자 정보를 active list에서 제거
+static void removeUserFromActiveList(uint8_t userId)
+{
+    removeUserFromList(myBooth.activeList, &myBooth.currentCount, MAX_BOOTH_CAPACITY, userId);
+}
+
+// 관리자 명령을 처리하는 키보드 입력 핸들러
+static void L3admin_processKeyboardInput(void)
+{
+    static char msgBuffer[101]; // 커스텀 메시지 버퍼 (최대 100자)
+    static uint8_t msgIndex = 0;
+    static uint8_t isTypingMessage = 0;
+
+    char c = pc.getc();
+
+    if (isTypingMessage)
+    {
+        // 사용자가 커스텀 메시지 입력 중
+        if (c == '\r' || c == '\n')
+        {
+            // 메시지 입력 완료
+            msgBuffer[msgIndex] = '\0';
+
+            if (msgIndex > 0)
+            {
+                // 활성 사용자에게만 메시지 방송 (현재 activeList에 있는 사용자)
+                pc.printf("\nBroadcasting to active users: \"%s\"\n", msgBuffer);
+                
+                uint8_t adminMsg[110];
+                uint8_t msgSize = L3_msg_encodeAdminMessage(adminMsg, msgBuffer);
+                
+                if (myBooth.currentCount > 0)
+                {
+                    // 부스 그룹 멀티캐스트 한 번 (빠진 사용자는 NACK 으로 재전송 받음)
+                    if (L3_group_send(adminMsg, msgSize))
+                    {
+                        pc.printf("Message sent to %d active user(s).\n\n", myBooth.currentCount);
+                    }
+                    else
+                    {
+                        pc.printf("Message could not be sent, try again.\n\n");
+                    }
+                }
+                else
+                {
+                    pc.printf("No active users in booth.\n\n");
+                }
+            }
+
+            // 입력 상태 초기화
+            isTypingMessage = 0;
+            msgIndex = 0;
+        }
+        else if (c == '\b' || c == 127)
+        {
+            // 백스페이스 입력 처리
+            if (msgIndex > 0)
+            {
+                msgIndex--;
+                pc.printf("\b \b"); // 터미널에서 문자 지우기
+            }
+        }
+        else if (msgIndex < 100)
+        {
+            // 버퍼에 문자 추가 및 에코 출력
+            msgBuffer[msgIndex++] = c;
+            pc.putc(c);
+        }
+    }
+    else
+    {
+        // 명령 모드: 단일 문자 입력으로 명령 처리
+        switch (c)
+        {
+        case 'm':
+        case 'M':
+            pc.printf("\nEnter broadcast message (max 100 chars): ");
+            isTypingMessage = 1;
+            msgIndex = 0;
+            break;
+
+        case 's':
+        case 'S':
+            // 부스 상태 정보 출력 (관리자 측)
+            pc.printf("\n=== BOOTH STATUS ===\n");
+            pc.printf("Booth ID: %d\n", myBooth.boothId);
+            pc.printf("Current Users: %d/%d\n", myBooth.currentCount, myBooth.capacity);
+            pc.printf("Waiting Queue: %d users\n", L3_waitQueue_getCount());
+            pc.printf("Announce Interval: %d ms%s\n", L3_trickle_getIntervalMs(), quietMode ? " (quiet mode)" : "");
+            pc.printf("Total Registered: %d users\n", L3_registry_getCount());
+            pc.printf("Held Requests: %d (refused scan %d, connect %d, register/join %d)\n",
+                      L3_admission_getPendingCount(), L3_admission_getRefusedCount(L3_ADMISSION_SCAN),
+                      L3_admission_getRefusedCount(L3_ADMISSION_CONNECT), L3_admission_getRefusedCount(L3_ADMISSION_JOIN));
+            pc.printf("Session Duration: %d seconds\n", SESSION_DURATION_MS / 1000);
+
+            if (myBooth.currentCount > 0)
+            {
+                pc.printf("\nActive Users:\n");
+                uint32_t currentTime = L3_timer_getMs();
+                for (uint8_t i = 0; i < myBooth.currentCount; i++)
+                {
+                    uint32_t sessionTime = (currentTime - myBooth.activeList[i].sessionStartTime) / 1000;
+                    uint32_t remainingTime = (SESSION_DURATION_MS / 1000) - sessionTime;
+                    pc.printf("  - User %d (Time remaining: %d sec)\n",
+                              myBooth.activeList[i].userId, remainingTime);
+                }
+            }
+
+            if (L3_registry_getCount() > 0)
+            {
+                pc.printf("\nRegistered Users (all-time):\n");
+                for (uint16_t i = 0; i < L3_registry_getCount(); i++)
+                {
+                    const L3_registryRecord_t *record = L3_registry_getRecord(i);
+                    pc.printf("  - User %d (checked in at %d sec)\n", record->userId, record->checkInTime / 1000);
+                }
+            }
+            pc.printf("==================\n\n");
+            break;
+
+        case 't': // Show timer status (관리자 측 세션 타이머 확인)
+        case 'T':
+            pc.printf("\n=== SESSION TIMERS ===\n");
+            if (myBooth.currentCount > 0)
+            {
+                uint32_t currentTime = L3_timer_getMs();
+                for (uint8_t i = 0; i < myBooth.currentCount; i++)
+                {
+                    uint32_t elapsedTime = (currentTime - myBooth.activeList[i].sessionStartTime) / 1000;
+                    uint32_t remainingTime = (SESSION_DURATION_MS / 1000) - elapsedTime;
+
+                    pc.printf("User %d: ", myBooth.activeList[i].userId);
+                    if (remainingTime > 0)
+                    {
+                        pc.printf("%d seconds remaining", remainingTime);
+                        if (remainingTime < 10)
+                        {
+                            pc.printf(" EXPIRING SOON!");
+                        }
+                    }
+                    else
+                    {
+                        pc.printf("EXPIRED!");
+                    }
+                    pc.printf("\n");
+                }
+            }
+            else
+            {
+                pc.printf("No active users.\n");
+            }
+            pc.printf("====================\n\n");
+            break;
+
+        case 'a':
+        case 'A':
+        {
+            // 부스 정보 재방송 (관리자 측)
+            pc.printf("\nSending booth announcement...\n");
+            uint8_t announceData[10];
+            uint8_t msgSize = encodeAnnounce(announceData);
+            L3_LLI_dataReqFunc(announceData, msgSize, BROADCAST_ID);
+            L3_trickle_hear(); // 이번 간격의 자동 방송은 생략
+            pc.printf("Announcement sent!\n\n");
+            break;
+        }
+
+        case 'q':
+        case 'Q':
+            // 조용 모드 토글: 자동 방송 중지/재개
+            quietMode = !quietMode;
+            pc.printf("\nQuiet mode: %s\n", quietMode ? "ON (auto-broadcasts disabled)" : "OFF (auto-broadcasts enabled)");
+            pc.printf("Manual broadcasts with 'a' still work in quiet mode.\n\n");
+            break;
+
+        case 'w':
+        case 'W':
+            // 현재 대기 큐 상태 출력 (관리자 측)
+            pc.printf("\n=== WAITING QUEUE ===\n");
+            if (L3_waitQueue_getCount() > 0)
+            {
+                pc.printf("Waiting users: %d\n", L3_waitQueue_getCount());
+                L3_waitQueue_forEach(printWaitingUser);
+            }
+            else
+            {
+                pc.printf("No users waiting.\n");
+            }
+            pc.printf("===================\n\n");
+            break;
+
+        case 'r':
+        case 'R':
+            // 메시지 타입별 처리 통계 출력 (handled / unexpected / dropped)
+            pc.printf("\n=== MESSAGE STATISTICS ===\n");
+            for (uint8_t t = 0; t < L3_MSG_TYPE_NB; t++)
+            {
+                uint32_t handled = L3_handler_getHandledCount(t);
+                uint32_t unexpected = L3_handler_getUnexpectedCount(t);
+                uint32_t dropped = L3_handler_getDroppedCount(t);
+
+                if (handled + unexpected + dropped > 0)
+                {
+                    pc.printf("  Type 0x%02X: handled %d, unexpected %d, dropped %d\n",
+                              t, handled, unexpected, dropped);
+                }
+            }
+            if (L3_handler_getInvalidCount() > 0)
+            {
+                pc.printf("  Unknown types: dropped %d\n", L3_handler_getInvalidCount());
+            }
+            pc.printf("==========================\n\n");
+            break;
+
+        case 'f':
+        case 'F':
+            // 다른 부스 상태 출력 (BOOTH_ANNOUNCE 로 들은 내용)
+            pc.printf("\n=== OTHER BOOTHS ===\n");
+            for (uint8_t i = 0; L3_fed_getPeer(i) != NULL; i++)
+            {
+                printPeer(L3_fed_getPeer(i));
+            }
+            pc.printf("====================\n\n");
+            break;
+
+        case 'h':
+        case 'H':
+            // 관리자 도움말 출력
+            pc.printf("\n=== ADMIN COMMANDS ===\n");
+            pc.printf("  'm' - Send custom broadcast message\n");
+            pc.printf("  's' - Show booth status\n");
+            pc.printf("  'a' - Send announcement\n");
+            pc.printf("  'q' - Toggle quiet mode\n");
+            pc.printf("  't' - Show session timers\n");
+            pc.printf("  'w' - Show waiting queue\n");
+            pc.printf("  'r' - Show message statistics\n");
+            pc.printf("  'f' - Show other booths\n");
+            pc.printf("  'h' - Show this help\n");
+            pc.printf("====================\n\n");
+            break;
+        }
+    }
+}
@@ -0,0 +1,219 @@
+#include "mbed.h"
+#include "L3_admission.h"
+#include "protocol_parameters.h"
+
+typedef struct {
+    uint32_t periodMs;    // 토큰 하나가 차는 주기 (ms, 0 : 제한 없음)
+    uint8_t burst;        // 최대 토큰 수
+    uint8_t tokens;       // 남은 토큰 수
+    uint32_t refillTime;  // 마지막으로 토큰을 채운 시각 (ms)
+    uint32_t nextGrant;   // 거절한 요청에 아직 예약하지 않은 다음 토큰 시각 (ms)
+    uint32_t refusedCnt;  // 거절한 요청 수
+} L3_bucket_t;
+
+typedef struct {
+    uint8_t userId;
+    uint8_t reqType;
+    uint8_t reqId;
+} L3_pendingReq_t;
+
+static L3_bucket_t buckets[L3_ADMISSION_NB];
+static L3_pendingReq_t pending[L3_ADMISSION_PENDING_SIZE]; // 보류 큐 (도착 순)
+static uint8_t nbPending = 0;
+
+
+// 지난 시간만큼 토큰 채움 (가득 차면 채운 시각을 현재로)
+static void refill(L3_bucket_t *bucket, uint32_t now)
+{
+    uint32_t nbNew = (now - bucket->refillTime) / bucket->periodMs;
+    if (bucket->tokens + nbNew >= bucket->burst)
+    {
+        bucket->tokens = bucket->burst;
+        bucket->refillTime = now;
+        return;
+    }
+
+    bucket->tokens += nbNew;
+    bucket->refillTime += nbNew * bucket->periodMs;
+}
+
+// 다음 토큰이 찰 때까지 남은 시간 (ms)
+static uint32_t waitMs(L3_bucket_t *bucket, uint32_t now)
+{
+    if (bucket->tokens > 0)
+    {
+        return 0;
+    }
+    return bucket->periodMs - (now - bucket->refillTime);
+}
+
+static uint16_t clampRetryMs(uint32_t ms)
+{
+    return (ms > L3_ADMISSION_MAXRETRYMS) ? L3_ADMISSION_MAXRETRYMS : (uint16_t)ms;
+}
+
+void L3_admission_init(uint32_t now)
+{
+    static const uint32_t periodMs[L3_ADMISSION_NB] = {
+        L3_ADMISSION_SCAN_PERIODMS, L3_ADMISSION_CONNECT_PERIODMS, L3_ADMISSION_JOIN_PERIODMS };
+    static const uint8_t burst[L3_ADMISSION_NB] = {
+        L3_ADMISSION_SCAN_BURST, L3_ADMISSION_CONNECT_BURST, L3_ADMISSION_JOIN_BURST };
+
+    for (uint8_t i = 0; i < L3_ADMISSION_NB; i++)
+    {
+        buckets[i].periodMs = periodMs[i];
+        buckets[i].burst = burst[i];
+        buckets[i].tokens = burst[i];
+        buckets[i].refillTime = now;
+        buckets[i].nextGrant = now;
+        buckets[i].refusedCnt = 0;
+    }
+    nbPending = 0;
+}
+
+uint8_t L3_admission_take(uint8_t cls, uint32_t now)
+{
+    L3_bucket_t *bucket = &buckets[cls];
+    if (bucket->periodMs == 0)
+    {
+        return 1;
+    }
+
+    // 보류 중인 등록/입장 요청이 있으면 새 요청은 그 뒤로
+    refill(bucket, now);
+    if (bucket->tokens == 0 || (cls == L3_ADMISSION_JOIN && nbPending > 0))
+    {
+        bucket->refusedCnt++;
+        return 0;
+    }
+
+    bucket->tokens--;
+    return 1;
+}
+
+uint16_t L3_admission_reserve(uint8_t cls, uint32_t now)
+{
+    L3_bucket_t *bucket = &buckets[cls];
+    if (bucket->periodMs == 0)
+    {
+        return 0;
+    }
+
+    // 등록/입장은 보류 요청들이 먼저 토큰을 씀
+    refill(bucket, now);
+    uint32_t grant = now + waitMs(bucket, now);
+    if (cls == L3_ADMISSION_JOIN && nbPending > 0)
+    {
+        grant += nbPending * bucket->periodMs;
+    }
+    if ((int32_t)(bucket->nextGrant - grant) > 0)
+    {
+        grant = bucket->nextGrant;
+    }
+    bucket->nextGrant = grant + bucket->periodMs;
+
+    return clampRetryMs(grant - now);
+}
+
+uint8_t L3_admission_enqueue(uint8_t userId, uint8_t reqType, uint8_t reqId)
+{
+    for (uint8_t i = 0; i < nbPending; i++)
+    {
+        if (pending[i].userId == userId)
+        {
+            pending[i].reqType = reqType;
+            pending[i].reqId = reqId;
+            return i + 1;
+        }
+    }
+
+    if (nbPending >= L3_ADMISSION_PENDING_SIZE)
+    {
+        return 0;
+    }
+
+    pending[nbPending].userId = userId;
+    pending[nbPending].reqType = reqType;
+    pending[nbPending].reqId = reqId;
+    nbPending++;
+    return nbPending;
+}
+
+uint8_t L3_admission_findPending(uint8_t userId, uint8_t reqType, uint8_t reqId)
+{
+    for (uint8_t i = 0; i < nbPending; i++)
+    {
+        if (pending[i].userId == userId && pending[i].reqType == reqType && pending[i].reqId == reqId)
+        {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+uint16_t L3_admission_pendingMs(uint8_t position, uint32_t now)
+{
+    L3_bucket_t *bucket = &buckets[L3_ADMISSION_JOIN];
+    if (bucket->periodMs == 0 || position == 0)
+    {
+        return 0;
+    }
+
+    refill(bucket, now);
+    return clampRetryMs(waitMs(bucket, now) + (uint32_t)(position - 1) * bucket->periodMs);
+}
+
+void L3_admission_cancel(uint8_t userId)
+{
+    for (uint8_t i = 0; i < nbPending; i++)
+    {
+        if (pending[i].userId == userId)
+        {
+            for (uint8_t j = i; j + 1 < nbPending; j++)
+            {
+                pending[j] = pending[j + 1];
+            }
+            nbPending--;
+            return;
+        }
+    }
+}
+
+uint8_t L3_admission_popPending(uint32_t now, uint8_t *userId, uint8_t *reqType, uint8_t *reqId)
+{
+    if (nbPending == 0)
+    {
+        return 0;
+    }
+
+    L3_bucket_t *bucket = &buckets[L3_ADMISSION_JOIN];
+    if (bucket->periodMs != 0)
+    {
+        refill(bucket, now);
+        if (bucket->tokens == 0)
+        {
+            return 0;
+        }
+        bucket->tokens--;
+    }
+
+    *userId = pending[0].userId;
+    *reqType = pending[0].reqType;
+    *reqId = pending[0].reqId;
+    for (uint8_t j = 0; j + 1 < nbPending; j++)
+    {
+        pending[j] = pending[j + 1];
+    }
+    nbPending--;
+    return 1;
+}
+
+uint8_t L3_admission_getPendingCount(void)
+{
+    return nbPending;
+}
+
+uint32_t L3_admission_getRefusedCount(uint8_t cls)
+{
+    return buckets[cls].refusedCnt;
+}
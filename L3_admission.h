@@ -0,0 +1,46 @@
+#ifndef L3_ADMISSION_H
+#define L3_ADMISSION_H
+
+#include "mbed.h"
+
+// 요청 수락 제어 (관리자 측): 사용자가 한꺼번에 몰릴 때 요청 종류별로 처리량 제한
+//   - 종류마다 토큰 버킷: 주기마다 토큰 하나가 차고 최대 burst 개까지 모임, 요청 하나에 토큰 하나
+//   - 토큰이 없는 등록/입장 요청은 보류 큐에 넣고 토큰이 찰 때 순서대로 처리
+//   - 거절한 요청에는 다음 토큰 시각을 하나씩 예약해 알려줌 (재시도가 한 시점에 몰리지 않도록)
+
+#define L3_ADMISSION_SCAN               0     // BOOTH_SCAN
+#define L3_ADMISSION_CONNECT            1     // CONNECT_REQUEST
+#define L3_ADMISSION_JOIN               2     // REGISTER_REQUEST, JOIN_REQUEST (보류 큐 사용)
+#define L3_ADMISSION_NB                 3
+
+// 초기화: 모든 버킷을 가득 채움, 보류 큐 비움
+void L3_admission_init(uint32_t now);
+
+// 토큰이 있으면 하나 쓰고 1 (제한이 꺼진 종류는 항상 1, 등록/입장은 보류 요청이 있으면 0)
+uint8_t L3_admission_take(uint8_t cls, uint32_t now);
+
+// 거절한 요청의 재시도 대기 시간 (ms): 아직 예약되지 않은 다음 토큰 시각까지 (등록/입장은 보류 요청 뒤)
+uint16_t L3_admission_reserve(uint8_t cls, uint32_t now);
+
+// 등록/입장 요청 보류: 보류 큐 순번 (1 부터) 반환, 가득 찼으면 0 (사용자마다 한 항목, 같은 사용자는 새 요청으로 대체)
+uint8_t L3_admission_enqueue(uint8_t userId, uint8_t reqType, uint8_t reqId);
+
+// 같은 요청이 보류 중이면 순번 (1 부터), 아니면 0
+uint8_t L3_admission_findPending(uint8_t userId, uint8_t reqType, uint8_t reqId);
+
+// position 번째 보류 요청이 처리될 때까지 남은 예상 시간 (ms)
+uint16_t L3_admission_pendingMs(uint8_t position, uint32_t now);
+
+// 사용자의 보류 요청 취소 (대기열을 떠나거나 퇴장)
+void L3_admission_cancel(uint8_t userId);
+
+// 보류 요청이 있고 토큰이 있으면 가장 오래된 요청을 꺼내 1
+uint8_t L3_admission_popPending(uint32_t now, uint8_t *userId, uint8_t *reqType, uint8_t *reqId);
+
+// 보류 중인 요청 수
+uint8_t L3_admission_getPendingCount(void);
+
+// 종류별로 토큰이 없어 거절(보류 포함)한 요청 수 (상태 출력용)
+uint32_t L3_admission_getRefusedCount(uint8_t cls);
+
+#endif // L3_ADMISSION_H
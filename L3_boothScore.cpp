@@ -0,0 +1,116 @@
+#include "mbed.h"
+#include "L3_boothScore.h"
+#include "L3_role.h"
+#include "protocol_parameters.h"
+
+// RSSI 이동 평균은 1/16 dB 단위 고정소수점으로 보관
+#define RSSI_AVG_SHIFT          4
+
+static L3_boothScoreFunc_t scorePolicy = L3_boothScore_balanced;
+static L3_boothScoreWeights_t scoreWeights;
+
+
+void L3_boothScore_init(void)
+{
+    scorePolicy = L3_boothScore_balanced;
+    scoreWeights.rssiWeight = L3_BOOTHSCORE_RSSIWEIGHT;
+    scoreWeights.freeSlotBonus = L3_BOOTHSCORE_FREEBONUS;
+    scoreWeights.waitPenalty = L3_BOOTHSCORE_WAITPENALTY;
+    scoreWeights.hysteresis = L3_BOOTHSCORE_HYSTERESIS;
+}
+
+void L3_boothScore_setPolicy(L3_boothScoreFunc_t policy)
+{
+    scorePolicy = (policy != NULL) ? policy : L3_boothScore_balanced;
+}
+
+void L3_boothScore_setWeights(const L3_boothScoreWeights_t *weights)
+{
+    scoreWeights = *weights;
+}
+
+const L3_boothScoreWeights_t* L3_boothScore_getWeights(void)
+{
+    return &scoreWeights;
+}
+
+void L3_boothScore_addRssi(BoothScanInfo_t *booth, int16_t rssi)
+{
+    int32_t sample = (int32_t)rssi << RSSI_AVG_SHIFT;
+
+    // 첫 샘플은 그대로, 이후는 최근 샘플에 1/2^L3_BOOTHSCORE_RSSIALPHA 가중
+    if (booth->rssiSamples == 0)
+    {
+        booth->rssiAvg = sample;
+    }
+    else
+    {
+        booth->rssiAvg += (sample - booth->rssiAvg) / (1 << L3_BOOTHSCORE_RSSIALPHA);
+    }
+
+    if (booth->rssiSamples < 255)
+    {
+        booth->rssiSamples++;
+    }
+}
+
+int16_t L3_boothScore_getRssi(const BoothScanInfo_t *booth)
+{
+    if (booth->rssiSamples == 0)
+    {
+        return booth->rssi;
+    }
+
+    return (int16_t)(booth->rssiAvg / (1 << RSSI_AVG_SHIFT));
+}
+
+uint32_t L3_boothScore_predictWaitMs(const BoothScanInfo_t *booth)
+{
+    // 부스가 실제 세션 길이로 계산해 알려준 값이 있으면 그대로 사용
+    if (booth->etaSec != L3_ETA_UNKNOWN)
+    {
+        return (uint32_t)booth->etaSec * 1000;
+    }
+
+    if (booth->currentCount < booth->capacity)
+    {
+        return 0;
+    }
+
+    // 자리 하나가 평균 세션 길이마다 비므로, 내 앞 인원 + 나를 정원으로 나눈 만큼 기다림
+    uint8_t capacity = (booth->capacity > 0) ? booth->capacity : 1;
+    return ((uint32_t)booth->waitingCount + 1) * L3_BOOTHSCORE_SESSIONMS / capacity;
+}
+
+int32_t L3_boothScore_score(const BoothScanInfo_t *booth)
+{
+    return scorePolicy(booth, &scoreWeights);
+}
+
+
+// 기본 정책 -------------------------------------------------
+
+int32_t L3_boothScore_balanced(const BoothScanInfo_t *booth, const L3_boothScoreWeights_t *weights)
+{
+    int32_t score = (int32_t)L3_boothScore_getRssi(booth) * weights->rssiWeight;
+
+    // 정원 초과로 보고된 부스도 음수로 넘어가지 않도록 비교로 판단
+    if (booth->currentCount < booth->capacity)
+    {
+        score += weights->freeSlotBonus;
+    }
+
+    score -= (int32_t)(L3_boothScore_predictWaitMs(booth) / 10000) * weights->waitPenalty;
+    return score;
+}
+
+int32_t L3_boothScore_nearest(const BoothScanInfo_t *booth, const L3_boothScoreWeights_t *weights)
+{
+    return (int32_t)L3_boothScore_getRssi(booth) * weights->rssiWeight;
+}
+
+int32_t L3_boothScore_shortestWait(const BoothScanInfo_t *booth, const L3_boothScoreWeights_t *weights)
+{
+    // 예상 대기 1초가 신호 차이보다 항상 크게 (RSSI 범위는 -128 ~ 0)
+    return -(int32_t)(L3_boothScore_predictWaitMs(booth) / 1000) * 256 + L3_boothScore_getRssi(booth);
+}
@@ -0,0 +1,45 @@
+#ifndef L3_BOOTHSCORE_H
+#define L3_BOOTHSCORE_H
+
+#include "mbed.h"
+#include "L3_types.h"
+
+// 부스 점수 가중치 (점수가 클수록 좋은 부스)
+typedef struct {
+    int16_t rssiWeight;       // 평균 RSSI 1dB 당 점수
+    int16_t freeSlotBonus;    // 빈 자리가 있을 때 보너스
+    int16_t waitPenalty;      // 예상 대기 10초 당 감점
+    int16_t hysteresis;       // 직전에 고른 부스를 바꾸려면 넘어야 하는 점수 차
+} L3_boothScoreWeights_t;
+
+// 점수 정책: 부스 정보와 가중치로 점수 계산 (교체 가능)
+typedef int32_t (*L3_boothScoreFunc_t)(const BoothScanInfo_t *booth, const L3_boothScoreWeights_t *weights);
+
+// 기본 정책/가중치로 초기화 (protocol_parameters.h 의 L3_BOOTHSCORE_*)
+void L3_boothScore_init(void);
+
+// 점수 정책 교체 (NULL 이면 기본 정책)
+void L3_boothScore_setPolicy(L3_boothScoreFunc_t policy);
+
+// 가중치 변경 / 조회
+void L3_boothScore_setWeights(const L3_boothScoreWeights_t *weights);
+const L3_boothScoreWeights_t* L3_boothScore_getWeights(void);
+
+// 방송 한 번의 RSSI 를 부스의 이동 평균에 반영
+void L3_boothScore_addRssi(BoothScanInfo_t *booth, int16_t rssi);
+
+// 평균 RSSI (dBm)
+int16_t L3_boothScore_getRssi(const BoothScanInfo_t *booth);
+
+// 지금 합류하면 입장까지 예상 대기 시간 (ms, 부스가 알려준 값 우선, 없으면 대기 인원 × 평균 세션 길이)
+uint32_t L3_boothScore_predictWaitMs(const BoothScanInfo_t *booth);
+
+// 현재 정책으로 계산한 점수
+int32_t L3_boothScore_score(const BoothScanInfo_t *booth);
+
+// 기본 제공 정책
+int32_t L3_boothScore_balanced(const BoothScanInfo_t *booth, const L3_boothScoreWeights_t *weights);     // 신호 + 빈 자리 + 예상 대기 (기본)
+int32_t L3_boothScore_nearest(const BoothScanInfo_t *booth, const L3_boothScoreWeights_t *weights);      // 신호만
+int32_t L3_boothScore_shortestWait(const BoothScanInfo_t *booth, const L3_boothScoreWeights_t *weights); // 예상 대기 우선, 신호는 동점 처리용
+
+#endif // L3_BOOTHSCORE_H
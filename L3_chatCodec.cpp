@@ -0,0 +1,236 @@
+#include "mbed.h"
+#include "L3_chatCodec.h"
+
+#define L3_CHATCODEC_ESCAPE     0x01    // 원문 구간: [ESCAPE][길이][원래 바이트들]
+#define L3_CHATCODEC_HANGUL     0x10    // 한글 구간: [HANGUL + 글자 수 - 1][글자마다 2바이트 (U+AC00 부터의 번호)]
+#define L3_CHATCODEC_HANGULMAX  16      // 한글 구간 하나의 최대 글자 수 (0x10 ~ 0x1F)
+#define L3_CHATCODEC_CODEBASE   0x80    // 사전 코드 시작 (최대 128개)
+
+#define L3_CHATCODEC_SYLLABLE0  0xAC00  // 한글 완성형 첫 글자 (가)
+#define L3_CHATCODEC_SYLLABLENB 11172   // 한글 완성형 글자 수 (가 ~ 힣)
+
+// 정적 사전: 부스 채팅에 자주 나오는 단어, 띄어쓰기 포함 조각, 한국어 인사/어미
+//   - 한글은 UTF-8 로 글자당 3바이트라 한 글자 항목도 2바이트를 줄임
+//   - 순서를 바꾸면 코드가 바뀌므로 항목은 끝에만 추가
+static const char *const dict[] = {
+    // 영어 단어 (앞뒤 공백 포함 조각)
+    " the ", "the ", " you", "you ", " are ", " is ", " it ", "it's ",
+    "this ", "that ", "what ", "where ", "when ", "how ", "here", "there",
+    "booth", "queue", "waiting", "wait", " line", "long", "time", "minute",
+    "thank you", "thanks", "hello", "please", "okay", "yes", " no ", "good",
+    "great", "nice", "cool", "come ", "going", "see ", "let's ", "now",
+    "next", "turn", "free", "photo", "try ", "can ", "I'm ", "don't ",
+    "ing ", "ing", "ed ", "er ", " and ", " to ", " of ", " in ",
+    " for ", " on ", " with ", " have ", " just ", " so ", " not ", "lol",
+    "haha", "really", "people", "here?", "?? ", "!! ", "...", " we ",
+    // 한국어 인사/표현
+    "안녕하세요", "감사합니다", "고마워요", "ㅋㅋㅋ", "ㅋㅋ", "ㅎㅎ", "아니요", "좋아요",
+    "재밌어요", "여기", "거기", "부스", "대기", "입장", "체험", "언제",
+    "어디", "얼마나", "기다려", "있어요", "없어요", "해요", "합니다", "입니다",
+    "에서 ", "으로 ", "는 ", "은 ", "이 ", "가 ", "를 ", "을 ",
+    "도 ", "요 ", "요", "다 ", "줄", "사람", "지금", "빨리",
+    "다음", "시간", "분 ", "정말", "진짜", "같이", "네 ", "나요",
+};
+
+#define L3_CHATCODEC_DICTSIZE   ((uint8_t)(sizeof(dict) / sizeof(dict[0])))
+
+
+// text[pos] 부터 가장 길게 맞는 사전 항목 (없으면 -1)
+static int16_t findLongest(const char *text, uint8_t textLen, uint8_t pos, uint8_t *matchLen)
+{
+    int16_t best = -1;
+    *matchLen = 0;
+    for (uint8_t i = 0; i < L3_CHATCODEC_DICTSIZE && i < 0x100 - L3_CHATCODEC_CODEBASE; i++)
+    {
+        uint8_t len = strlen(dict[i]);
+        if (len > *matchLen && len <= textLen - pos && memcmp(&text[pos], dict[i], len) == 0)
+        {
+            best = i;
+            *matchLen = len;
+        }
+    }
+    return best;
+}
+
+// text[pos] 가 한글 완성형 글자 (UTF-8 3바이트) 면 U+AC00 부터의 번호, 아니면 -1
+static int16_t getSyllable(const char *text, uint8_t textLen, uint8_t pos)
+{
+    if (textLen - pos < 3)
+    {
+        return -1;
+    }
+
+    uint8_t b0 = (uint8_t)text[pos];
+    uint8_t b1 = (uint8_t)text[pos + 1];
+    uint8_t b2 = (uint8_t)text[pos + 2];
+    if ((b0 & 0xF0) != 0xE0 || (b1 & 0xC0) != 0x80 || (b2 & 0xC0) != 0x80)
+    {
+        return -1;
+    }
+
+    uint16_t cp = ((uint16_t)(b0 & 0x0F) << 12) | ((uint16_t)(b1 & 0x3F) << 6) | (b2 & 0x3F);
+    if (cp < L3_CHATCODEC_SYLLABLE0 || cp >= L3_CHATCODEC_SYLLABLE0 + L3_CHATCODEC_SYLLABLENB)
+    {
+        return -1;
+    }
+    return cp - L3_CHATCODEC_SYLLABLE0;
+}
+
+// 그대로 둘 수 없는 바이트 (원문 구간에 넣음): 구간 표시 바이트와 사전 코드 영역
+static uint8_t isReserved(uint8_t c)
+{
+    return c == L3_CHATCODEC_ESCAPE || c >= L3_CHATCODEC_CODEBASE ||
+           (c >= L3_CHATCODEC_HANGUL && c < L3_CHATCODEC_HANGUL + L3_CHATCODEC_HANGULMAX);
+}
+
+uint8_t L3_chatCodec_compress(const char *text, uint8_t textLen, uint8_t *out, uint8_t outSize)
+{
+    uint8_t outLen = 0;
+    uint8_t pos = 0;
+    while (pos < textLen)
+    {
+        // 원문 이상이면 더 볼 필요 없음
+        if (outLen >= textLen - 1)
+        {
+            return 0;
+        }
+
+        uint8_t matchLen;
+        int16_t code = findLongest(text, textLen, pos, &matchLen);
+        if (code >= 0 && matchLen > 1)
+        {
+            if (outLen + 1 > outSize)
+            {
+                return 0;
+            }
+            out[outLen++] = L3_CHATCODEC_CODEBASE + code;
+            pos += matchLen;
+            continue;
+        }
+
+        if (getSyllable(text, textLen, pos) >= 0)
+        {
+            // 사전에 없는 한글: 이어지는 글자를 한 구간으로 묶어 글자당 2바이트
+            uint8_t start = outLen++;
+            uint8_t count = 0;
+            int16_t syllable;
+            while (count < L3_CHATCODEC_HANGULMAX && (syllable = getSyllable(text, textLen, pos)) >= 0 &&
+                   !(findLongest(text, textLen, pos, &matchLen) >= 0 && matchLen > 1))
+            {
+                if (outLen + 2 > outSize)
+                {
+                    return 0;
+                }
+                out[outLen++] = (uint8_t)(syllable >> 8);
+                out[outLen++] = (uint8_t)syllable;
+                pos += 3;
+                count++;
+            }
+            out[start] = L3_CHATCODEC_HANGUL + count - 1;
+            continue;
+        }
+
+        uint8_t c = (uint8_t)text[pos];
+        if (isReserved(c))
+        {
+            // 그 밖의 UTF-8 문자 (이모지 등) 와 예약 바이트: 이어지는 바이트를 한 원문 구간으로
+            uint8_t start = outLen;
+            outLen += 2;
+            uint8_t count = 0;
+            while (pos < textLen && count < 0xFF && isReserved((uint8_t)text[pos]) &&
+                   getSyllable(text, textLen, pos) < 0 &&
+                   !(findLongest(text, textLen, pos, &matchLen) >= 0 && matchLen > 1))
+            {
+                if (outLen + 1 > outSize)
+                {
+                    return 0;
+                }
+                out[outLen++] = (uint8_t)text[pos++];
+                count++;
+            }
+            out[start] = L3_CHATCODEC_ESCAPE;
+            out[start + 1] = count;
+            continue;
+        }
+
+        if (outLen + 1 > outSize)
+        {
+            return 0;
+        }
+        out[outLen++] = c;
+        pos++;
+    }
+
+    return (outLen < textLen) ? outLen : 0;
+}
+
+// 복원한 조각을 덧붙임 (textSize - 1 자에서 자름)
+static void append(char *text, uint8_t *textLen, uint8_t textSize, const char *piece, uint8_t pieceLen)
+{
+    if (*textLen + pieceLen > textSize - 1)
+    {
+        pieceLen = textSize - 1 - *textLen;
+    }
+    memcpy(&text[*textLen], piece, pieceLen);
+    *textLen += pieceLen;
+}
+
+uint8_t L3_chatCodec_expand(const uint8_t *in, uint8_t inLen, char *text, uint8_t textSize)
+{
+    uint8_t textLen = 0;
+    uint8_t pos = 0;
+    while (pos < inLen)
+    {
+        uint8_t c = in[pos++];
+
+        if (c == L3_CHATCODEC_ESCAPE)
+        {
+            if (pos >= inLen || in[pos] == 0 || in[pos] > inLen - pos - 1)
+            {
+                return 0;
+            }
+            uint8_t count = in[pos++];
+            append(text, &textLen, textSize, (const char *)&in[pos], count);
+            pos += count;
+        }
+        else if (c >= L3_CHATCODEC_HANGUL && c < L3_CHATCODEC_HANGUL + L3_CHATCODEC_HANGULMAX)
+        {
+            uint8_t count = c - L3_CHATCODEC_HANGUL + 1;
+            if (count * 2 > inLen - pos)
+            {
+                return 0;
+            }
+            for (uint8_t i = 0; i < count; i++, pos += 2)
+            {
+                uint16_t syllable = ((uint16_t)in[pos] << 8) | in[pos + 1];
+                if (syllable >= L3_CHATCODEC_SYLLABLENB)
+                {
+                    return 0;
+                }
+                uint16_t cp = L3_CHATCODEC_SYLLABLE0 + syllable;
+                char utf8[3];
+                utf8[0] = (char)(0xE0 | (cp >> 12));
+                utf8[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+                utf8[2] = (char)(0x80 | (cp & 0x3F));
+                append(text, &textLen, textSize, utf8, 3);
+            }
+        }
+        else if (c >= L3_CHATCODEC_CODEBASE)
+        {
+            if (c - L3_CHATCODEC_CODEBASE >= L3_CHATCODEC_DICTSIZE)
+            {
+                return 0;
+            }
+            const char *piece = dict[c - L3_CHATCODEC_CODEBASE];
+            append(text, &textLen, textSize, piece, strlen(piece));
+        }
+        else
+        {
+            char literal = (char)c;
+            append(text, &textLen, textSize, &literal, 1);
+        }
+    }
+
+    text[textLen] = '\0';
+    return 1;
+}
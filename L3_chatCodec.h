@@ -0,0 +1,19 @@
+#ifndef L3_CHATCODEC_H
+#define L3_CHATCODEC_H
+
+#include "mbed.h"
+
+// 채팅 문장 압축 (정적 사전)
+//   - 자주 쓰는 영어/한국어 단어와 어미를 1바이트 코드(0x80 ~)로 바꿈, 나머지 ASCII 는 그대로
+//   - 사전에 없는 한글 완성형은 이어지는 글자를 한 구간으로 묶어 글자당 2바이트 (UTF-8 은 3바이트)
+//   - 그 밖의 0x80 이상 바이트 (이모지 등) 와 구간 표시 바이트 (0x01, 0x10 ~ 0x1F) 는 길이를 붙인 원문 구간으로
+//     (나머지 제어 문자는 그대로)
+//   - 길이는 L3 메시지 길이로 정해지므로 널 종료 없음
+
+// 압축: 압축 길이 반환, 원문보다 짧아지지 않거나 outSize 를 넘으면 0 (원문 그대로 보냄)
+uint8_t L3_chatCodec_compress(const char *text, uint8_t textLen, uint8_t *out, uint8_t outSize);
+
+// 복원: 널 종료 문자열로 풀어 1 반환 (textSize - 1 자에서 자름), 잘못된 코드면 0
+uint8_t L3_chatCodec_expand(const uint8_t *in, uint8_t inLen, char *text, uint8_t textSize);
+
+#endif // L3_CHATCODEC_H
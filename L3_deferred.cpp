@@ -0,0 +1,154 @@
+#include "mbed.h"
+#include "L3_deferred.h"
+#include "L3_LLinterface.h"
+#include "L3_timer.h"
+#include "protocol_parameters.h"
+
+// 지연 동작 슬롯 (전송 또는 함수 호출)
+typedef struct
+{
+    uint8_t inUse;
+    uint32_t seq;                         // 같은 만기 시각일 때 예약 순서 유지
+    uint32_t dueMs;                       // 실행 시각 (L3_timer_getMs 기준)
+    L3_deferredFunc_t func;               // NULL 이면 메시지 전송
+    uint8_t destId;
+    uint8_t size;
+    uint8_t msg[L3_DEFERRED_MAXMSGSIZE];
+} L3_deferred_t;
+
+static L3_deferred_t deferredQueue[L3_DEFERRED_QUEUESIZE];
+static volatile uint8_t deferredCount = 0;
+static uint32_t deferredSeq = 0;
+
+
+// 빈 슬롯을 잡아 공통 필드 채움 (critical section 안에서 호출)
+static L3_deferred_t* allocSlot(uint32_t delayMs)
+{
+    for (uint8_t i = 0; i < L3_DEFERRED_QUEUESIZE; i++)
+    {
+        if (!deferredQueue[i].inUse)
+        {
+            deferredQueue[i].inUse = 1;
+            deferredQueue[i].seq = deferredSeq++;
+            deferredQueue[i].dueMs = L3_timer_getMs() + delayMs;
+            deferredCount++;
+            return &deferredQueue[i];
+        }
+    }
+
+    return NULL;
+}
+
+
+void L3_deferred_init(void)
+{
+    core_util_critical_section_enter();
+    for (uint8_t i = 0; i < L3_DEFERRED_QUEUESIZE; i++)
+    {
+        deferredQueue[i].inUse = 0;
+    }
+    deferredCount = 0;
+    core_util_critical_section_exit();
+}
+
+uint8_t L3_deferred_send(const uint8_t* msg, uint8_t size, uint8_t destId, uint32_t delayMs)
+{
+    if (size > L3_DEFERRED_MAXMSGSIZE)
+    {
+        debug("[L3][WARNING] deferred message too long (%i)\n", size);
+        return 0;
+    }
+
+    core_util_critical_section_enter();
+    L3_deferred_t* slot = allocSlot(delayMs);
+    if (slot != NULL)
+    {
+        slot->func = NULL;
+        slot->destId = destId;
+        slot->size = size;
+        memcpy(slot->msg, msg, size);
+    }
+    core_util_critical_section_exit();
+
+    return (slot != NULL);
+}
+
+uint8_t L3_deferred_call(L3_deferredFunc_t func, uint32_t delayMs)
+{
+    core_util_critical_section_enter();
+    L3_deferred_t* slot = allocSlot(delayMs);
+    if (slot != NULL)
+    {
+        slot->func = func;
+        slot->size = 0;
+    }
+    core_util_critical_section_exit();
+
+    return (slot != NULL);
+}
+
+void L3_deferred_run(void)
+{
+    if (deferredCount == 0)
+    {
+        return;
+    }
+
+    uint32_t now = L3_timer_getMs();
+    L3_deferred_t action;
+    uint8_t found = 0;
+
+    // 만기된 것 중 가장 먼저 만기된 동작을 꺼냄 (wrap 대비 부호 있는 차이로 비교)
+    core_util_critical_section_enter();
+    int best = -1;
+    for (uint8_t i = 0; i < L3_DEFERRED_QUEUESIZE; i++)
+    {
+        if (!deferredQueue[i].inUse || (int32_t)(now - deferredQueue[i].dueMs) < 0)
+        {
+            continue;
+        }
+
+        if (best < 0)
+        {
+            best = i;
+            continue;
+        }
+
+        int32_t diff = (int32_t)(deferredQueue[i].dueMs - deferredQueue[best].dueMs);
+        if (diff < 0 || (diff == 0 && (int32_t)(deferredQueue[i].seq - deferredQueue[best].seq) < 0))
+        {
+            best = i;
+        }
+    }
+
+    if (best >= 0)
+    {
+        action = deferredQueue[best];
+        deferredQueue[best].inUse = 0;
+        deferredCount--;
+        found = 1;
+    }
+    core_util_critical_section_exit();
+
+    if (!found)
+    {
+        return;
+    }
+
+    if (action.func != NULL)
+    {
+        action.func();
+    }
+    else
+    {
+        if (L3_LLI_dataReqFunc(action.msg, action.size, action.destId) == 0)
+        {
+            debug("[L3][WARNING] deferred message to %i rejected by L2\n", action.destId);
+        }
+    }
+}
+
+uint8_t L3_deferred_getCount(void)
+{
+    return deferredCount;
+}
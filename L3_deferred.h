@@ -0,0 +1,26 @@
+#ifndef L3_DEFERRED_H
+#define L3_DEFERRED_H
+
+#include "mbed.h"
+
+// 지연 실행 함수 (메인 루프 컨텍스트에서 호출됨)
+typedef void (*L3_deferredFunc_t)(void);
+
+// 큐 초기화 (대기 중인 동작 모두 폐기)
+void L3_deferred_init(void);
+
+// delayMs 후 메시지 전송 예약 (메시지는 복사됨), 큐가 가득 차면 0 반환
+// ISR 에서도 호출 가능
+uint8_t L3_deferred_send(const uint8_t* msg, uint8_t size, uint8_t destId, uint32_t delayMs);
+
+// delayMs 후 함수 호출 예약, 큐가 가득 차면 0 반환
+// ISR 에서도 호출 가능
+uint8_t L3_deferred_call(L3_deferredFunc_t func, uint32_t delayMs);
+
+// 만기된 동작을 하나 실행 (L3_FSMrun 에서 매 루프 호출)
+void L3_deferred_run(void);
+
+// 대기 중인 동작 수
+uint8_t L3_deferred_getCount(void);
+
+#endif // L3_DEFERRED_H
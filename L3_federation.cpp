@@ -0,0 +1,132 @@
+#include "mbed.h"
+#include "L3_federation.h"
+#include "L3_msg.h"
+
+// 관리자(부스) ID 범위 전체
+#define L3_FED_NBBOOTH          (ADMIN_ID_END - ADMIN_ID_START + 1)
+
+// uint8_t ID 공간 전체 (256개) 비트맵 크기
+#define L3_FED_BITMAPSIZE       (256 / 32)
+
+static uint8_t myId = 0;
+static L3_fedPeer_t peers[L3_FED_NBBOOTH];
+
+// 부스별 체험 기록 비트맵 (FED_REGISTER 로 수신)
+static uint32_t registeredBitmap[L3_FED_NBBOOTH][L3_FED_BITMAPSIZE];
+
+// 다른 부스로 안내한 사용자 비트맵
+static uint32_t offeredBitmap[L3_FED_BITMAPSIZE];
+
+
+static L3_fedPeer_t* getPeerSlot(uint8_t boothId)
+{
+    if (boothId < ADMIN_ID_START || boothId > ADMIN_ID_END || boothId == myId)
+    {
+        return NULL;
+    }
+    return &peers[boothId - ADMIN_ID_START];
+}
+
+void L3_fed_init(uint8_t myBoothId)
+{
+    myId = myBoothId;
+
+    for (uint8_t i = 0; i < L3_FED_NBBOOTH; i++)
+    {
+        peers[i].boothId = 0;
+        peers[i].isOffered = 0;
+        for (uint8_t j = 0; j < L3_FED_BITMAPSIZE; j++)
+        {
+            registeredBitmap[i][j] = 0;
+        }
+    }
+    for (uint8_t j = 0; j < L3_FED_BITMAPSIZE; j++)
+    {
+        offeredBitmap[j] = 0;
+    }
+}
+
+void L3_fed_updatePeer(uint8_t boothId, uint8_t currentCount, uint8_t capacity,
+                       uint8_t waitingCount, uint16_t etaSec, uint32_t now)
+{
+    L3_fedPeer_t *peer = getPeerSlot(boothId);
+    if (peer == NULL)
+    {
+        return;
+    }
+
+    peer->boothId = boothId;
+    peer->currentCount = currentCount;
+    peer->capacity = capacity;
+    peer->waitingCount = waitingCount;
+    peer->etaSec = etaSec;
+    peer->lastHeardTime = now;
+    peer->isOffered = 0;
+}
+
+void L3_fed_addRegistration(uint8_t boothId, uint8_t userId)
+{
+    if (getPeerSlot(boothId) == NULL)
+    {
+        return;
+    }
+
+    registeredBitmap[boothId - ADMIN_ID_START][userId >> 5] |= ((uint32_t)0x01 << (userId & 0x1F));
+}
+
+uint8_t L3_fed_isRegistered(uint8_t boothId, uint8_t userId)
+{
+    if (getPeerSlot(boothId) == NULL)
+    {
+        return 0;
+    }
+
+    return (registeredBitmap[boothId - ADMIN_ID_START][userId >> 5] >> (userId & 0x1F)) & 0x01;
+}
+
+const L3_fedPeer_t* L3_fed_findBestPeer(uint8_t userId, uint32_t now, uint32_t maxAgeMs)
+{
+    const L3_fedPeer_t *best = NULL;
+
+    for (uint8_t i = 0; i < L3_FED_NBBOOTH; i++)
+    {
+        const L3_fedPeer_t *peer = &peers[i];
+        if (peer->boothId == 0 || peer->isOffered || peer->etaSec == L3_ETA_UNKNOWN ||
+            now - peer->lastHeardTime > maxAgeMs || L3_fed_isRegistered(peer->boothId, userId))
+        {
+            continue;
+        }
+
+        if (best == NULL || peer->etaSec < best->etaSec)
+        {
+            best = peer;
+        }
+    }
+    return best;
+}
+
+void L3_fed_markOffered(uint8_t boothId, uint8_t userId)
+{
+    L3_fedPeer_t *peer = getPeerSlot(boothId);
+    if (peer != NULL)
+    {
+        peer->isOffered = 1;
+    }
+
+    offeredBitmap[userId >> 5] |= ((uint32_t)0x01 << (userId & 0x1F));
+}
+
+uint8_t L3_fed_wasOffered(uint8_t userId)
+{
+    return (offeredBitmap[userId >> 5] >> (userId & 0x1F)) & 0x01;
+}
+
+const L3_fedPeer_t* L3_fed_getPeer(uint8_t index)
+{
+    if (index >= L3_FED_NBBOOTH)
+    {
+        return NULL;
+    }
+
+    return &peers[index];
+}
@@ -0,0 +1,44 @@
+#ifndef L3_FEDERATION_H
+#define L3_FEDERATION_H
+
+#include "mbed.h"
+
+// 부스 간 연합 (관리자 측)
+//   - 다른 관리자의 BOOTH_ANNOUNCE 로 부스별 현재 인원/대기 인원/예상 시간을 기록
+//   - FED_REGISTER 로 다른 부스의 체험 기록 공유 (이미 체험한 부스로는 안내하지 않음)
+
+// 다른 부스 상태 (BOOTH_ANNOUNCE 마지막 수신 내용)
+typedef struct {
+    uint8_t boothId;          // 부스 ID (0 : 소식 없음)
+    uint8_t currentCount;     // 현재 이용자 수
+    uint8_t capacity;         // 정원
+    uint8_t waitingCount;     // 대기 인원
+    uint16_t etaSec;          // 새로 합류하는 사용자의 예상 입장 시간 (초)
+    uint32_t lastHeardTime;   // 마지막 수신 시각 (ms, L3_timer_getMs 기준)
+    uint8_t isOffered;        // 마지막 수신 이후 이 부스로 안내함 (다음 방송까지 중복 안내 안 함)
+} L3_fedPeer_t;
+
+// 연합 초기화 (myBoothId : 자기 부스, 목록에서 제외)
+void L3_fed_init(uint8_t myBoothId);
+
+// 다른 부스의 BOOTH_ANNOUNCE 반영
+void L3_fed_updatePeer(uint8_t boothId, uint8_t currentCount, uint8_t capacity,
+                       uint8_t waitingCount, uint16_t etaSec, uint32_t now);
+
+// 다른 부스의 체험 기록 반영 / 조회
+void L3_fed_addRegistration(uint8_t boothId, uint8_t userId);
+uint8_t L3_fed_isRegistered(uint8_t boothId, uint8_t userId);
+
+// userId 가 체험하지 않았고 maxAgeMs 이내에 소식이 있는 부스 중 가장 빨리 입장할 수 있는 부스 (없으면 NULL)
+const L3_fedPeer_t* L3_fed_findBestPeer(uint8_t userId, uint32_t now, uint32_t maxAgeMs);
+
+// 부스로 사용자를 안내함: 다음 BOOTH_ANNOUNCE 까지 같은 부스로 다시 안내하지 않음 (몰림 방지)
+void L3_fed_markOffered(uint8_t boothId, uint8_t userId);
+
+// 이미 안내를 받은 사용자인지 (사용자당 한 번)
+uint8_t L3_fed_wasOffered(uint8_t userId);
+
+// index 번째 부스 상태 ('f' 명령 출력용, 범위 밖이면 NULL)
+const L3_fedPeer_t* L3_fed_getPeer(uint8_t index);
+
+#endif // L3_FEDERATION_H
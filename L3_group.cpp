@@ -0,0 +1,208 @@
+#include "mbed.h"
+#include "L3_group.h"
+#include "L3_msg.h"
+#include "L3_LLinterface.h"
+#include "protocol_parameters.h"
+
+// 수신 측이 기억하는 최근 시퀀스 번호 범위 (중복/재전송 판별)
+#define L3_GROUP_RECVWINDOW     32
+
+// NACK 한 번에 요청할 수 있는 번호 수 (base + mask 8비트)
+#define L3_GROUP_NACKSPAN       9
+
+// 재전송은 이력 전체를 한 번에 L2 큐에 넣을 수 있음 (같은 루프의 방송/스냅샷 몫도 남겨 둠)
+#if L2_TXQUEUE_SIZE < L3_GROUP_HISTORY_SIZE + 4
+#error "L2_TXQUEUE_SIZE is too small for a full group repair burst"
+#endif
+
+// 송신 이력: seq % L3_GROUP_HISTORY_SIZE 자리에 저장 (크기는 256 의 약수)
+typedef struct
+{
+    uint8_t seq;
+    uint8_t size;                         // 0 이면 빈 자리
+    uint8_t msg[L3_GROUP_MAXMSGSIZE];
+} L3_groupHistory_t;
+
+static uint8_t txGroupId = 0;
+static uint8_t txSeq = 0;
+static L3_groupHistory_t txHistory[L3_GROUP_HISTORY_SIZE];
+
+static uint8_t rxGroupId = 0;
+static uint8_t rxSynced = 0;              // 첫 프레임을 받았는지
+static uint8_t rxExpectedSeq = 0;         // 다음에 올 시퀀스 번호
+static uint32_t rxMask = 0;               // i 번째 비트 : (rxExpectedSeq - 1 - i) 번 수신함
+
+
+void L3_group_initSender(uint8_t groupId)
+{
+    txGroupId = groupId;
+    txSeq = 0;
+    for (uint8_t i = 0; i < L3_GROUP_HISTORY_SIZE; i++)
+    {
+        txHistory[i].size = 0;
+    }
+}
+
+uint8_t L3_group_send(const uint8_t* inner, uint8_t innerLen)
+{
+    if (L3_MSG_OFFSET_DATA + L3_GROUP_OFFSET_INNER + innerLen > L3_GROUP_MAXMSGSIZE)
+    {
+        return 0;
+    }
+
+    // 번호 할당과 이력 기록은 메인 루프/ISR 사이에서 섞이지 않도록 보호
+    core_util_critical_section_enter();
+    L3_groupHistory_t* entry = &txHistory[txSeq % L3_GROUP_HISTORY_SIZE];
+    entry->seq = txSeq;
+    entry->size = L3_msg_encodeGroupData(entry->msg, txGroupId, txSeq, inner, innerLen);
+    txSeq++;
+
+    uint8_t msg[L3_GROUP_MAXMSGSIZE];
+    uint8_t size = entry->size;
+    memcpy(msg, entry->msg, size);
+    core_util_critical_section_exit();
+
+    // 전송이 거부돼도 이력에는 남아 있으므로 NACK 으로 복구 가능
+    return L3_LLI_dataReqFunc(msg, size, BROADCAST_ID) != 0;
+}
+
+uint8_t L3_group_repair(uint8_t destId, uint8_t* nackMsg, uint8_t size)
+{
+    if (size < L3_MSG_OFFSET_DATA + L3_GROUP_NACK_OFFSET_MASK + 1)
+    {
+        return 0;
+    }
+
+    uint8_t* data = L3_msg_getData(nackMsg);
+    if (data[L3_GROUP_NACK_OFFSET_ID] != txGroupId)
+    {
+        return 0;
+    }
+
+    uint8_t baseSeq = data[L3_GROUP_NACK_OFFSET_BASE];
+    uint16_t wanted = ((uint16_t)data[L3_GROUP_NACK_OFFSET_MASK] << 1) | 0x01;
+    uint8_t nbRepaired = 0;
+
+    for (uint8_t i = 0; i < L3_GROUP_NACKSPAN; i++)
+    {
+        if ((wanted & (0x01 << i)) == 0)
+        {
+            continue;
+        }
+
+        uint8_t seq = baseSeq + i;
+        uint8_t msg[L3_GROUP_MAXMSGSIZE];
+        uint8_t msgSize = 0;
+
+        core_util_critical_section_enter();
+        L3_groupHistory_t* entry = &txHistory[seq % L3_GROUP_HISTORY_SIZE];
+        if (entry->size > 0 && entry->seq == seq)
+        {
+            msgSize = entry->size;
+            memcpy(msg, entry->msg, msgSize);
+        }
+        core_util_critical_section_exit();
+
+        // 이미 이력에서 밀려난 프레임은 복구 불가
+        if (msgSize == 0)
+        {
+            continue;
+        }
+
+        // 재전송은 요청한 사용자에게만 유니캐스트 (ARQ 로 보호됨)
+        //   - L2 큐가 가득 차면 나머지도 들어가지 않으므로 중단 (사용자가 다시 NACK)
+        if (!L3_LLI_dataReqFunc(msg, msgSize, destId))
+        {
+            break;
+        }
+        nbRepaired++;
+    }
+
+    return nbRepaired;
+}
+
+
+void L3_group_initReceiver(uint8_t groupId)
+{
+    rxGroupId = groupId;
+    rxSynced = 0;
+    rxExpectedSeq = 0;
+    rxMask = 0;
+}
+
+// rxExpectedSeq 부터 seq 직전까지 빠진 번호를 요청
+static void sendNack(uint8_t srcId, uint8_t seq)
+{
+    uint8_t nbMissing = seq - rxExpectedSeq;
+    uint8_t mask = 0;
+
+    for (uint8_t i = 1; i < nbMissing && i < L3_GROUP_NACKSPAN; i++)
+    {
+        mask |= (0x01 << (i - 1));
+    }
+
+    uint8_t nackMsg[L3_MSG_OFFSET_DATA + L3_GROUP_NACK_OFFSET_MASK + 1];
+    uint8_t nackSize = L3_msg_encodeGroupNack(nackMsg, rxGroupId, rxExpectedSeq, mask);
+    L3_LLI_dataReqFunc(nackMsg, nackSize, srcId);
+}
+
+uint8_t* L3_group_receive(uint8_t srcId, uint8_t* msg, uint8_t size, uint8_t* innerLen)
+{
+    if (!L3_msg_checkGroupData(msg, size))
+    {
+        // 조각 유실로 손상된 프레임: 다음 프레임에서 빈 번호로 드러나 NACK 됨
+        return NULL;
+    }
+
+    uint8_t* data = L3_msg_getData(msg);
+    if (data[L3_GROUP_OFFSET_ID] != rxGroupId)
+    {
+        return NULL;
+    }
+
+    uint8_t seq = data[L3_GROUP_OFFSET_SEQ];
+    if (!rxSynced)
+    {
+        // 입장 후 첫 프레임부터 받음 (그 이전 번호는 요청하지 않음)
+        rxSynced = 1;
+        rxExpectedSeq = seq + 1;
+        rxMask = 0x01;
+    }
+    else
+    {
+        int8_t diff = (int8_t)(uint8_t)(seq - rxExpectedSeq);
+        if (diff >= 0)
+        {
+            // 새 프레임: 사이에 빠진 번호가 있으면 NACK
+            if (diff > 0)
+            {
+                sendNack(srcId, seq);
+            }
+            rxMask = (diff + 1 >= L3_GROUP_RECVWINDOW) ? 0 : (rxMask << (diff + 1));
+            rxMask |= 0x01;
+            rxExpectedSeq = seq + 1;
+        }
+        else
+        {
+            // 지난 번호: 아직 받지 못한 것(재전송)만 전달
+            uint8_t offset = (uint8_t)(rxExpectedSeq - 1 - seq);
+            if (offset >= L3_GROUP_RECVWINDOW)
+            {
+                // 기억 범위를 한참 벗어남 (관리자 재시작 등): 이 번호부터 다시 맞춤
+                rxExpectedSeq = seq + 1;
+                rxMask = 0x01;
+            }
+            else if (rxMask & ((uint32_t)0x01 << offset))
+            {
+                return NULL;
+            }
+            else
+            {
+                rxMask |= ((uint32_t)0x01 << offset);
+            }
+        }
+    }
+
+    *innerLen = data[L3_GROUP_OFFSET_LEN];
+    return &data[L3_GROUP_OFFSET_INNER];
+}
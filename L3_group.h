@@ -0,0 +1,32 @@
+#ifndef L3_GROUP_H
+#define L3_GROUP_H
+
+#include "mbed.h"
+
+// 부스 그룹 멀티캐스트 (GROUP_DATA / GROUP_NACK)
+//   - 관리자는 그룹 메시지를 방송 한 번으로 보내고 최근 L3_GROUP_HISTORY_SIZE 개를 보관
+//   - 사용자는 시퀀스 번호의 빈 곳을 발견하면 빠진 번호만 GROUP_NACK 으로 요청
+//   - 마지막 프레임의 유실은 다음 그룹 프레임이 도착할 때 발견됨
+
+// 송신 측 (관리자) ---------------------------------------------
+
+// 그룹 ID 설정 및 보관 이력 초기화
+void L3_group_initSender(uint8_t groupId);
+
+// 내부 메시지를 GROUP_DATA 로 감싸 방송, 성공 시 1 (너무 길거나 L2 가 거부하면 0)
+// ISR 에서도 호출 가능
+uint8_t L3_group_send(const uint8_t* inner, uint8_t innerLen);
+
+// GROUP_NACK 에 적힌 프레임 중 보관 중인 것을 destId 에게 재전송, 재전송한 프레임 수 반환
+uint8_t L3_group_repair(uint8_t destId, uint8_t* nackMsg, uint8_t size);
+
+// 수신 측 (사용자) ---------------------------------------------
+
+// 수신할 그룹 설정 및 시퀀스 상태 초기화 (부스 입장 시)
+void L3_group_initReceiver(uint8_t groupId);
+
+// GROUP_DATA 처리: 처음 받는 프레임이면 내부 메시지 포인터 반환 (다른 그룹/중복/손상이면 NULL)
+// 빠진 번호가 있으면 srcId 에게 GROUP_NACK 전송
+uint8_t* L3_group_receive(uint8_t srcId, uint8_t* msg, uint8_t size, uint8_t* innerLen);
+
+#endif // L3_GROUP_H
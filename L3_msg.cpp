@@ -1,5 +1,7 @@
 #include "mbed.h"
 #include "L3_msg.h"
+#include "L3_chatCodec.h"
+#include "protocol_parameters.h"
 #include <string.h>
 
 // 버퍼에서 메시지 타입을 읽어 반환 (첫 번째 바이트)
@@ -21,12 +23,16 @@ uint8_t L3_msg_encodeUserInfoRequest(uint8_t* msg) {
 }
 
 // CONNECT_REQUEST 메시지 인코딩
-//   - 타입 + 사용자 ID 포함
-//   - 전체 메시지 크기: 2바이트
-uint8_t L3_msg_encodeConnectRequest(uint8_t* msg, uint8_t userId) {
+//   - 타입 + 사용자가 캐시한 부스 정보 버전 + 요청 ID (둘 다 없으면 타입만, 1바이트)
+//   - 전체 메시지 크기: 1 또는 3바이트
+uint8_t L3_msg_encodeConnectRequest(uint8_t* msg, uint8_t cachedInfoVersion, uint8_t reqId) {
     msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_CONNECT_REQUEST;
-    msg[L3_MSG_OFFSET_DATA] = userId;
-    return 2;
+    if (cachedInfoVersion == L3_INFOVER_NONE && reqId == L3_REQID_NONE) {
+        return L3_MSG_OFFSET_DATA;
+    }
+    msg[L3_MSG_OFFSET_DATA + L3_CONNECT_OFFSET_INFOVER] = cachedInfoVersion;
+    msg[L3_MSG_OFFSET_DATA + L3_CONNECT_OFFSET_REQID] = reqId;
+    return L3_MSG_OFFSET_DATA + L3_CONNECT_OFFSET_REQID + 1;
 }
 
 // USER_RESPONSE 메시지 인코딩
@@ -42,16 +48,32 @@ uint8_t L3_msg_encodeUserResponse(uint8_t* msg, uint8_t response) {
 //   - 타입 + 현재 사용자 수 + 정원 + 대기열 수 + 설명 문자열
 //   - 문자열은 널 종료 포함 복사
 uint8_t L3_msg_encodeBoothInfo(uint8_t* msg, uint8_t currentCount, uint8_t capacity, 
-                                uint8_t waitingCount, const char* description) {
+                                uint8_t waitingCount, const char* description, uint8_t infoVersion) {
     msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_BOOTH_INFO;
     msg[L3_MSG_OFFSET_DATA] = currentCount;
     msg[L3_MSG_OFFSET_DATA + 1] = capacity;
     msg[L3_MSG_OFFSET_DATA + 2] = waitingCount;
     
     uint8_t descLen = strlen(description);
-    memcpy(&msg[L3_MSG_OFFSET_DATA + 3], description, descLen + 1); // 널 종료 포함 복사
+    memcpy(&msg[L3_MSG_OFFSET_DATA + L3_BOOTHINFO_OFFSET_DESC], description, descLen + 1); // 널 종료 포함 복사
+
+    // 설명 뒤에 정보 버전 (사용자가 설명을 캐시하는 키)
+    msg[L3_MSG_OFFSET_DATA + L3_BOOTHINFO_OFFSET_DESC + descLen + 1] = infoVersion;
     
-    return L3_MSG_OFFSET_DATA + 3 + descLen + 1; // 전체 메시지 크기 반환
+    return L3_MSG_OFFSET_DATA + L3_BOOTHINFO_OFFSET_DESC + descLen + 2; // 전체 메시지 크기 반환
+}
+
+// BOOTH_INFO_SHORT 메시지 인코딩 (설명 생략)
+//   - 타입 + 현재 이용자 수 + 정원 + 대기 인원 + 정보 버전
+//   - 전체 메시지 크기: 5바이트
+uint8_t L3_msg_encodeBoothInfoShort(uint8_t* msg, uint8_t currentCount, uint8_t capacity,
+                                    uint8_t waitingCount, uint8_t infoVersion) {
+    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_BOOTH_INFO_SHORT;
+    msg[L3_MSG_OFFSET_DATA + L3_INFOSHORT_OFFSET_CURRENT] = currentCount;
+    msg[L3_MSG_OFFSET_DATA + L3_INFOSHORT_OFFSET_CAPACITY] = capacity;
+    msg[L3_MSG_OFFSET_DATA + L3_INFOSHORT_OFFSET_WAITING] = waitingCount;
+    msg[L3_MSG_OFFSET_DATA + L3_INFOSHORT_OFFSET_INFOVER] = infoVersion;
+    return L3_MSG_OFFSET_DATA + L3_INFOSHORT_OFFSET_INFOVER + 1;
 }
 
 // REGISTER_RESPONSE 메시지 인코딩
@@ -65,26 +87,96 @@ uint8_t L3_msg_encodeRegisterResponse(uint8_t* msg, uint8_t success, uint8_t rea
 }
 
 // QUEUE_INFO 메시지 인코딩
-//   - 타입 + 내 대기 순번 + 전체 대기 인원
-//   - 전체 메시지 크기: 3바이트
-uint8_t L3_msg_encodeQueueInfo(uint8_t* msg, uint8_t queueNumber, uint8_t totalWaiting) {
+//   - 타입 + 내 대기 순번 + 전체 대기 인원 + 예상 입장 시간 (초, 2바이트)
+//   - 전체 메시지 크기: 5바이트
+uint8_t L3_msg_encodeQueueInfo(uint8_t* msg, uint8_t queueNumber, uint8_t totalWaiting, uint16_t etaSec) {
     msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_QUEUE_INFO;
     msg[L3_MSG_OFFSET_DATA] = queueNumber;
     msg[L3_MSG_OFFSET_DATA + 1] = totalWaiting;
-    return 3;
+    msg[L3_MSG_OFFSET_DATA + L3_QUEUEINFO_OFFSET_ETA] = etaSec >> 8;
+    msg[L3_MSG_OFFSET_DATA + L3_QUEUEINFO_OFFSET_ETA + 1] = etaSec & 0xFF;
+    return 5;
+}
+
+// QUEUE_READY 인코딩 (입장 알림)
+//   - 타입 + 자리가 빌 때까지 남은 시간 (초, 0 : 지금 입장)
+uint8_t L3_msg_encodeQueueReady(uint8_t* msg, uint8_t leadSec) {
+    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_QUEUE_READY;
+    msg[L3_MSG_OFFSET_DATA + L3_QUEUEREADY_OFFSET_LEAD] = leadSec;
+    return L3_MSG_OFFSET_DATA + L3_QUEUEREADY_OFFSET_LEAD + 1;
+}
+
+// KEEPALIVE 인코딩 (사용자 생존 알림)
+//   - 타입 + 사용자 FSM 상태
+uint8_t L3_msg_encodeKeepalive(uint8_t* msg, uint8_t state) {
+    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_KEEPALIVE;
+    msg[L3_MSG_OFFSET_DATA + L3_KEEPALIVE_OFFSET_STATE] = state;
+    return L3_MSG_OFFSET_DATA + L3_KEEPALIVE_OFFSET_STATE + 1;
+}
+
+// FED_REGISTER 인코딩 (관리자 간 체험 기록 공유)
+uint8_t L3_msg_encodeFedRegister(uint8_t* msg, uint8_t userId) {
+    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_FED_REGISTER;
+    msg[L3_MSG_OFFSET_DATA + L3_FEDREG_OFFSET_USER] = userId;
+    return L3_MSG_OFFSET_DATA + L3_FEDREG_OFFSET_USER + 1;
+}
+
+// REDIRECT_OFFER 인코딩 (다른 부스 안내)
+//   - 타입 + 부스 ID + 예상 입장 시간 (상위 바이트 먼저)
+uint8_t L3_msg_encodeRedirectOffer(uint8_t* msg, uint8_t boothId, uint16_t etaSec) {
+    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_REDIRECT_OFFER;
+    msg[L3_MSG_OFFSET_DATA + L3_REDIRECT_OFFSET_BOOTH] = boothId;
+    msg[L3_MSG_OFFSET_DATA + L3_REDIRECT_OFFSET_ETA] = etaSec >> 8;
+    msg[L3_MSG_OFFSET_DATA + L3_REDIRECT_OFFSET_ETA + 1] = etaSec & 0xFF;
+    return L3_MSG_OFFSET_DATA + L3_REDIRECT_OFFSET_ETA + 2;
+}
+
+// BUSY 인코딩 (요청 처리 보류)
+//   - 타입 + 보류된 요청 타입 + 요청 ID + 재시도 대기 시간 (ms, 상위 바이트 먼저)
+uint8_t L3_msg_encodeBusy(uint8_t* msg, uint8_t reqType, uint8_t reqId, uint16_t retryMs) {
+    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_BUSY;
+    msg[L3_MSG_OFFSET_DATA + L3_BUSY_OFFSET_REQTYPE] = reqType;
+    msg[L3_MSG_OFFSET_DATA + L3_BUSY_OFFSET_REQID] = reqId;
+    msg[L3_MSG_OFFSET_DATA + L3_BUSY_OFFSET_RETRYMS] = retryMs >> 8;
+    msg[L3_MSG_OFFSET_DATA + L3_BUSY_OFFSET_RETRYMS + 1] = retryMs & 0xFF;
+    return L3_MSG_OFFSET_DATA + L3_BUSY_OFFSET_RETRYMS + 2;
+}
+
+// JOIN_RESPONSE 인코딩 (빠른 입장 응답)
+//   - 사유 코드 + 대기 순번 + 총 대기 인원 + 예상 입장 시간 (초)
+uint8_t L3_msg_encodeJoinResponse(uint8_t* msg, uint8_t reason, uint8_t queueNumber, uint8_t totalWaiting, uint16_t etaSec) {
+    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_JOIN_RESPONSE;
+    msg[L3_MSG_OFFSET_DATA + L3_JOIN_OFFSET_REASON] = reason;
+    msg[L3_MSG_OFFSET_DATA + L3_JOIN_OFFSET_POSITION] = queueNumber;
+    msg[L3_MSG_OFFSET_DATA + L3_JOIN_OFFSET_TOTAL] = totalWaiting;
+    msg[L3_MSG_OFFSET_DATA + L3_JOIN_OFFSET_ETA] = etaSec >> 8;
+    msg[L3_MSG_OFFSET_DATA + L3_JOIN_OFFSET_ETA + 1] = etaSec & 0xFF;
+    return L3_MSG_OFFSET_DATA + L3_JOIN_OFFSET_ETA + 2;
+}
+
+// BOOTH_SCAN 인코딩 (브로드캐스트 탐색)
+//   - 타입 + 응답 슬롯 수 + 슬롯 길이 (10ms 단위)
+uint8_t L3_msg_encodeBoothScan(uint8_t* msg, uint8_t nbSlots, uint16_t slotMs) {
+    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_BOOTH_SCAN;
+    msg[L3_MSG_OFFSET_DATA + L3_SCAN_OFFSET_NBSLOTS] = nbSlots;
+    msg[L3_MSG_OFFSET_DATA + L3_SCAN_OFFSET_SLOTLEN] = slotMs / L3_SCAN_SLOTUNIT_MS;
+    return L3_MSG_OFFSET_DATA + L3_SCAN_OFFSET_SLOTLEN + 1;
 }
 
 // BOOTH_ANNOUNCE 메시지 인코딩
-//   - 타입 + 부스 ID + 이용 중 사용자 수 + 정원 + 대기열 수
-//   - 전체 메시지 크기: 5바이트
+//   - 타입 + 부스 ID + 이용 중 사용자 수 + 정원 + 대기열 수 + 지금 합류 시 예상 입장 시간 (초, 2바이트)
+//   - 전체 메시지 크기: 7바이트
 uint8_t L3_msg_encodeBoothAnnounce(uint8_t* msg, uint8_t boothId, uint8_t currentCount, 
-                                   uint8_t capacity, uint8_t waitingCount) {
+                                   uint8_t capacity, uint8_t waitingCount, uint16_t etaSec, uint8_t infoVersion) {
     msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_BOOTH_ANNOUNCE;
     msg[L3_MSG_OFFSET_DATA] = boothId;
     msg[L3_MSG_OFFSET_DATA + 1] = currentCount;
     msg[L3_MSG_OFFSET_DATA + 2] = capacity;
     msg[L3_MSG_OFFSET_DATA + 3] = waitingCount;
-    return 5;
+    msg[L3_MSG_OFFSET_DATA + L3_ANNOUNCE_OFFSET_ETA] = etaSec >> 8;
+    msg[L3_MSG_OFFSET_DATA + L3_ANNOUNCE_OFFSET_ETA + 1] = etaSec & 0xFF;
+    msg[L3_MSG_OFFSET_DATA + L3_ANNOUNCE_OFFSET_INFOVER] = infoVersion;
+    return L3_MSG_OFFSET_DATA + L3_ANNOUNCE_OFFSET_INFOVER + 1;
 }
 
 // ADMIN_MESSAGE 메시지 인코딩
@@ -98,26 +190,283 @@ uint8_t L3_msg_encodeAdminMessage(uint8_t* msg, const char* message) {
     return L3_MSG_OFFSET_DATA + msgLen + 1;
 }
 
+// CHAT_COMPACT 인코딩: 압축해서 rawSize 보다 짧아지면 그 길이, 아니면 0 (호출한 쪽이 CHAT_MESSAGE 로 보냄)
+//   - 타입 + 플래그 + (발신자 ID) + 압축한 문장
+static uint8_t encodeChatCompact(uint8_t* msg, uint8_t hasSender, uint8_t senderId,
+                                 const char* message, uint8_t msgLen, uint8_t rawSize) {
+#if L3_CHAT_COMPRESS
+    uint8_t textPos = L3_MSG_OFFSET_DATA + L3_CHATC_OFFSET_SENDER + (hasSender ? 1 : 0);
+    uint8_t compact[L3_CHAT_MAXLEN];
+    uint8_t compactLen = L3_chatCodec_compress(message, msgLen, compact, sizeof(compact));
+    if (compactLen == 0 || textPos + compactLen >= rawSize) {
+        return 0;
+    }
+
+    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_CHAT_COMPACT;
+    msg[L3_MSG_OFFSET_DATA + L3_CHATC_OFFSET_FLAGS] = L3_CHATC_FLAG_DICT | (hasSender ? L3_CHATC_FLAG_SENDER : 0);
+    if (hasSender) {
+        msg[L3_MSG_OFFSET_DATA + L3_CHATC_OFFSET_SENDER] = senderId;
+    }
+    memcpy(&msg[textPos], compact, compactLen);
+    return textPos + compactLen;
+#else
+    return 0;
+#endif
+}
+
 // CHAT_MESSAGE 인코딩 (사용자가 Admin에게 보낼 때)
 //   - 타입 + 메시지 문자열
+//   - 압축하면 더 짧으면 CHAT_COMPACT 로 인코딩
 uint8_t L3_msg_encodeChatMessage(uint8_t* msg, const char* message) {
-    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_CHAT_MESSAGE;
     uint8_t msgLen = strlen(message);
-    if (msgLen > 100) msgLen = 100;  // 길이 제한
-    memcpy(&msg[L3_MSG_OFFSET_DATA], message, msgLen + 1); // 널 종료 포함
+    if (msgLen > L3_CHAT_MAXLEN) msgLen = L3_CHAT_MAXLEN;  // 길이 제한
+
+    uint8_t compactSize = encodeChatCompact(msg, 0, 0, message, msgLen, L3_MSG_OFFSET_DATA + msgLen + 1);
+    if (compactSize != 0) {
+        return compactSize;
+    }
+
+    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_CHAT_MESSAGE;
+    memcpy(&msg[L3_MSG_OFFSET_DATA], message, msgLen);
+    msg[L3_MSG_OFFSET_DATA + msgLen] = '\0'; // 널 종료 포함 (잘린 문장도)
     return L3_MSG_OFFSET_DATA + msgLen + 1;
 }
 
 // CHAT_MESSAGE 인코딩 (관리자가 중계할 때)
 //   - 타입 + 발신자 ID + 메시지 문자열
 //   - 발신자 ID 자리 하나 확보, 문자열 최대 99자로 제한
+//   - 압축하면 더 짧으면 CHAT_COMPACT 로 인코딩
 uint8_t L3_msg_encodeChatMessageWithSender(uint8_t* msg, uint8_t senderId, const char* message) {
+    uint8_t msgLen = strlen(message);
+    if (msgLen > L3_CHAT_MAXLEN - 1) msgLen = L3_CHAT_MAXLEN - 1;  // ID 바이트 공간 제외
+
+    uint8_t compactSize = encodeChatCompact(msg, 1, senderId, message, msgLen, L3_MSG_OFFSET_DATA + 1 + msgLen + 1);
+    if (compactSize != 0) {
+        return compactSize;
+    }
+
     msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_CHAT_MESSAGE;
     msg[L3_MSG_OFFSET_DATA] = senderId;  // 첫 번째 데이터 바이트는 발신자 ID
-    
-    uint8_t msgLen = strlen(message);
-    if (msgLen > 99) msgLen = 99;  // ID 바이트 공간 제외
-    memcpy(&msg[L3_MSG_OFFSET_DATA + 1], message, msgLen + 1); // 널 종료 포함
+    memcpy(&msg[L3_MSG_OFFSET_DATA + 1], message, msgLen);
+    msg[L3_MSG_OFFSET_DATA + 1 + msgLen] = '\0'; // 널 종료 포함 (잘린 문장도)
     
     return L3_MSG_OFFSET_DATA + 1 + msgLen + 1; // 전체 메시지 크기 반환
-}
\ No newline at end of file
+}
+
+// 0 ~ value 를 표현하는 데 필요한 비트 수
+static uint8_t L3_msg_bitWidth(uint8_t value) {
+    uint8_t width = 0;
+    while (value > 0) {
+        width++;
+        value >>= 1;
+    }
+    return width;
+}
+
+// QUEUE_SNAPSHOT 세그먼트 인코딩 (브로드캐스트용)
+//   - 타입 + 버전 + 총 대기 인원 + 첫 순번 + ID 수 + 기준 ID + 비트 수 + 비트 패킹된 (ID - 기준 ID)
+//   - userIds 앞에서부터 L3_SNAPSHOT_MAXSIZE 에 들어가는 만큼만 담고, 담은 개수를 nbEncoded 로 반환
+uint8_t L3_msg_encodeQueueSnapshot(uint8_t* msg, uint8_t version, uint8_t totalWaiting,
+                                   uint8_t firstPosition, const uint8_t* userIds,
+                                   uint8_t count, uint8_t* nbEncoded) {
+    uint8_t headerSize = L3_MSG_OFFSET_DATA + L3_SNAPSHOT_OFFSET_IDS;
+    uint8_t minId = (count > 0) ? userIds[0] : 0;
+    uint8_t maxId = minId;
+    uint8_t width = 0;
+    uint8_t n = 0;
+
+    // 기준 ID/비트 수를 늘려 가며 들어가는 만큼 선택
+    while (n < count) {
+        uint8_t newMin = (userIds[n] < minId) ? userIds[n] : minId;
+        uint8_t newMax = (userIds[n] > maxId) ? userIds[n] : maxId;
+        uint8_t newWidth = L3_msg_bitWidth(newMax - newMin);
+
+        if (headerSize + ((n + 1) * newWidth + 7) / 8 > L3_SNAPSHOT_MAXSIZE) {
+            break;
+        }
+        minId = newMin;
+        maxId = newMax;
+        width = newWidth;
+        n++;
+    }
+
+    uint8_t* data = &msg[L3_MSG_OFFSET_DATA];
+    uint8_t idsSize = (n * width + 7) / 8;
+
+    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_QUEUE_SNAPSHOT;
+    data[L3_SNAPSHOT_OFFSET_VERSION] = version;
+    data[L3_SNAPSHOT_OFFSET_TOTAL] = totalWaiting;
+    data[L3_SNAPSHOT_OFFSET_FIRSTPOS] = firstPosition;
+    data[L3_SNAPSHOT_OFFSET_COUNT] = n;
+    data[L3_SNAPSHOT_OFFSET_BASE] = minId;
+    data[L3_SNAPSHOT_OFFSET_WIDTH] = width;
+    memset(&data[L3_SNAPSHOT_OFFSET_IDS], 0, idsSize);
+
+    // LSB 부터 width 비트씩 이어 붙임
+    uint16_t bitPos = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        uint8_t delta = userIds[i] - minId;
+        for (uint8_t b = 0; b < width; b++) {
+            if (delta & (1 << b)) {
+                data[L3_SNAPSHOT_OFFSET_IDS + (bitPos >> 3)] |= (1 << (bitPos & 0x07));
+            }
+            bitPos++;
+        }
+    }
+
+    *nbEncoded = n;
+    return headerSize + idsSize;
+}
+
+// GROUP_DATA 인코딩 (부스 그룹 멀티캐스트, 방송 한 번으로 그룹 전체에 전달)
+//   - 타입 + 그룹 ID + 시퀀스 번호 + 내부 메시지 길이 + 내부 메시지
+uint8_t L3_msg_encodeGroupData(uint8_t* msg, uint8_t groupId, uint8_t seq,
+                               const uint8_t* inner, uint8_t innerLen) {
+    uint8_t* data = &msg[L3_MSG_OFFSET_DATA];
+
+    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_GROUP_DATA;
+    data[L3_GROUP_OFFSET_ID] = groupId;
+    data[L3_GROUP_OFFSET_SEQ] = seq;
+    data[L3_GROUP_OFFSET_LEN] = innerLen;
+    memcpy(&data[L3_GROUP_OFFSET_INNER], inner, innerLen);
+
+    return L3_MSG_OFFSET_DATA + L3_GROUP_OFFSET_INNER + innerLen;
+}
+
+// GROUP_NACK 인코딩 (수신자가 빠진 그룹 프레임을 관리자에게 요청)
+//   - 타입 + 그룹 ID + 첫 번째 빠진 번호 + 이후 8개 번호의 유실 비트맵
+uint8_t L3_msg_encodeGroupNack(uint8_t* msg, uint8_t groupId, uint8_t baseSeq, uint8_t mask) {
+    uint8_t* data = &msg[L3_MSG_OFFSET_DATA];
+
+    msg[L3_MSG_OFFSET_TYPE] = MSG_TYPE_GROUP_NACK;
+    data[L3_GROUP_NACK_OFFSET_ID] = groupId;
+    data[L3_GROUP_NACK_OFFSET_BASE] = baseSeq;
+    data[L3_GROUP_NACK_OFFSET_MASK] = mask;
+
+    return L3_MSG_OFFSET_DATA + L3_GROUP_NACK_OFFSET_MASK + 1;
+}
+
+// QUEUE_SNAPSHOT 세그먼트 길이 확인
+//   - 헤더와 count * width 비트가 모두 들어 있으면 1
+uint8_t L3_msg_checkQueueSnapshot(uint8_t* msg, uint8_t size) {
+    uint8_t headerSize = L3_MSG_OFFSET_DATA + L3_SNAPSHOT_OFFSET_IDS;
+    if (size < headerSize) {
+        return 0;
+    }
+
+    uint8_t* data = &msg[L3_MSG_OFFSET_DATA];
+    if (data[L3_SNAPSHOT_OFFSET_WIDTH] > 8) {
+        return 0;
+    }
+    return size >= headerSize + (data[L3_SNAPSHOT_OFFSET_COUNT] * data[L3_SNAPSHOT_OFFSET_WIDTH] + 7) / 8;
+}
+
+// QUEUE_SNAPSHOT 세그먼트의 index 번째 ID 디코딩
+uint8_t L3_msg_getQueueSnapshotId(uint8_t* msg, uint8_t index) {
+    uint8_t* data = &msg[L3_MSG_OFFSET_DATA];
+    uint8_t width = data[L3_SNAPSHOT_OFFSET_WIDTH];
+    uint16_t bitPos = (uint16_t)index * width;
+    uint8_t delta = 0;
+
+    for (uint8_t b = 0; b < width; b++) {
+        if (data[L3_SNAPSHOT_OFFSET_IDS + (bitPos >> 3)] & (1 << (bitPos & 0x07))) {
+            delta |= (1 << b);
+        }
+        bitPos++;
+    }
+    return data[L3_SNAPSHOT_OFFSET_BASE] + delta;
+}
+
+// GROUP_DATA 길이 확인
+//   - 방송은 ARQ 없이 조각 단위로 재조립되므로, 조각이 빠지면 길이가 맞지 않음
+uint8_t L3_msg_checkGroupData(uint8_t* msg, uint8_t size) {
+    uint8_t headerSize = L3_MSG_OFFSET_DATA + L3_GROUP_OFFSET_INNER;
+    if (size < headerSize) {
+        return 0;
+    }
+
+    return size == headerSize + msg[L3_MSG_OFFSET_DATA + L3_GROUP_OFFSET_LEN];
+}
+
+// 데이터 offset 위치의 예상 시간 (초) 디코딩
+//   - 예상 시간 필드가 없는 구 형식 메시지면 L3_ETA_UNKNOWN
+uint16_t L3_msg_getEta(uint8_t* msg, uint8_t size, uint8_t offset) {
+    if (size < L3_MSG_OFFSET_DATA + offset + 2) {
+        return L3_ETA_UNKNOWN;
+    }
+
+    uint8_t* data = &msg[L3_MSG_OFFSET_DATA];
+    return ((uint16_t)data[offset] << 8) | data[offset + 1];
+}
+
+// 데이터 offset 위치의 부스 정보 버전 디코딩
+//   - 버전 필드가 없는 구 형식 메시지면 L3_INFOVER_NONE
+uint8_t L3_msg_getInfoVersion(uint8_t* msg, uint8_t size, uint8_t offset) {
+    if (size < L3_MSG_OFFSET_DATA + offset + 1) {
+        return L3_INFOVER_NONE;
+    }
+
+    return msg[L3_MSG_OFFSET_DATA + offset];
+}
+
+// 요청 ID 디코딩 (재전송 요청 구분용)
+//   - 요청 ID 필드가 없는 구 형식 메시지면 L3_REQID_NONE
+uint8_t L3_msg_getReqId(uint8_t* msg, uint8_t size, uint8_t offset) {
+    if (size < L3_MSG_OFFSET_DATA + offset + 1) {
+        return L3_REQID_NONE;
+    }
+
+    return msg[L3_MSG_OFFSET_DATA + offset];
+}
+
+// CHAT_COMPACT 복원: 발신자 ID (없으면 0) 와 널 종료 문장
+//   - 모르는 압축 방식, 잘린 메시지, 잘못된 코드면 0
+uint8_t L3_msg_getChatCompact(uint8_t* msg, uint8_t size, uint8_t* senderId, char* text, uint8_t textSize) {
+    if (size < L3_MSG_OFFSET_DATA + L3_CHATC_OFFSET_FLAGS + 1) {
+        return 0;
+    }
+
+    uint8_t flags = msg[L3_MSG_OFFSET_DATA + L3_CHATC_OFFSET_FLAGS];
+    uint8_t textPos = L3_MSG_OFFSET_DATA + L3_CHATC_OFFSET_SENDER;
+    if ((flags & L3_CHATC_FLAG_DICT) == 0) {
+        return 0;
+    }
+
+    *senderId = 0;
+    if (flags & L3_CHATC_FLAG_SENDER) {
+        if (size < textPos + 1) {
+            return 0;
+        }
+        *senderId = msg[textPos];
+        textPos++;
+    }
+
+    return L3_chatCodec_expand(&msg[textPos], size - textPos, text, textSize);
+}
+
+// BOOTH_INFO 의 정보 버전 디코딩 (설명 문자열의 널 종료 바로 뒤)
+uint8_t L3_msg_getBoothInfoVersion(uint8_t* msg, uint8_t size) {
+    uint8_t pos = L3_MSG_OFFSET_DATA + L3_BOOTHINFO_OFFSET_DESC;
+    while (pos < size && msg[pos] != '\0') {
+        pos++;
+    }
+
+    // 널 종료가 없거나 버전 바이트가 없으면 구 형식
+    if (pos + 1 >= size) {
+        return L3_INFOVER_NONE;
+    }
+    return msg[pos + 1];
+}
+
+// 부스 정적 정보 버전 계산 (정원 + 설명의 8비트 FNV-1a 해시)
+//   - 관리자가 재시작해도 같은 설명이면 같은 버전, L3_INFOVER_NONE 은 쓰지 않음
+uint8_t L3_msg_infoVersion(uint8_t capacity, const char* description) {
+    uint32_t hash = 2166136261u;
+    hash = (hash ^ capacity) * 16777619u;
+    for (const char* c = description; *c != '\0'; c++) {
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+    }
+
+    uint8_t version = (hash >> 24) ^ (hash >> 16) ^ (hash >> 8) ^ hash;
+    return (version == L3_INFOVER_NONE) ? 1 : version;
+}
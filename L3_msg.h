@@ -25,6 +25,18 @@
 #define MSG_TYPE_QUEUE_UPDATE           0x13  // 대기 순번 업데이트
 #define MSG_TYPE_QUEUE_LEAVE            0x14  // 대기열 이탈 요청
 #define ALREADY_WAITING                 0x15  // 이미 대기열 있음
+#define MSG_TYPE_QUEUE_SNAPSHOT         0x16  // 대기열 스냅샷 방송 (순서대로 나열한 대기 사용자 ID)
+#define MSG_TYPE_GROUP_DATA             0x17  // 부스 그룹 멀티캐스트 (시퀀스 번호 + 내부 메시지)
+#define MSG_TYPE_GROUP_NACK             0x18  // 그룹 프레임 재전송 요청 (빠진 시퀀스 번호)
+#define MSG_TYPE_JOIN_REQUEST           0x19  // 빠른 입장 요청 (연결 + 등록 의사를 한 번에)
+#define MSG_TYPE_JOIN_RESPONSE          0x1A  // 빠른 입장 응답 (입장 / 대기 순번 / 이미 체험함)
+#define MSG_TYPE_BOOTH_INFO_SHORT       0x1B  // 부스 정보 (설명 생략, 사용자 캐시가 최신일 때)
+#define MSG_TYPE_KEEPALIVE              0x1C  // 사용자 생존 알림 (부스 안/대기 중 주기 전송)
+#define MSG_TYPE_FED_REGISTER           0x1D  // 관리자 간 체험 기록 공유 (방송)
+#define MSG_TYPE_REDIRECT_OFFER         0x1E  // 더 빨리 입장할 수 있는 다른 부스 안내 (대기 사용자에게)
+#define MSG_TYPE_BUSY                   0x1F  // 요청 처리 보류: 지정한 시간 뒤에 다시 보내라는 응답 (관리자 -> 사용자)
+#define MSG_TYPE_CHAT_COMPACT           0x20  // 압축한 채팅 메시지 (CHAT_MESSAGE 보다 짧을 때만 사용)
+#define L3_MSG_TYPE_NB                  0x21  // 메시지 타입 개수 (마지막 타입 + 1)
 
 // 사용자 응답 값
 #define USER_RESPONSE_YES               1     // y
@@ -34,6 +46,7 @@
 #define REGISTER_REASON_SUCCESS         0     // 등록 성공
 #define REGISTER_REASON_ALREADY_USED    1     // 이미 체험함
 #define REGISTER_REASON_FULL_WAITING    2     // 만원으로 대기열 등록됨
+#define REGISTER_REASON_QUEUE_FULL      3     // 만원이고 대기열도 가득 참
 
 // 특별 ID
 #define BROADCAST_ID                    255   // 전체 방송 대상 ID
@@ -42,41 +55,183 @@
 
 // 용량 및 제한
 #define MAX_BOOTH_CAPACITY              1     // 부스 정원
-#define MAX_USERS                       20    // 최대 사용자 수
 #define MAX_BOOTHS                      3     // 최대 부스 수
+#define L3_BOOTH_DESCSIZE               50    // 부스 설명 문자열 최대 크기 (널 종료 포함)
 
 // 메시지 구조 내 오프셋
 #define L3_MSG_OFFSET_TYPE              0     // 타입 필드 위치
 #define L3_MSG_OFFSET_DATA              1     // 데이터 시작 위치
 
+// QUEUE_SNAPSHOT 데이터 필드 위치 (L3_msg_getData 기준)
+//   - 한 세그먼트는 firstPosition 번부터 count 명의 ID 를 (ID - base) 를 width 비트씩 이어 붙여 담음
+#define L3_SNAPSHOT_OFFSET_VERSION      0     // 스냅샷 버전 (대기열이 바뀔 때마다 증가)
+#define L3_SNAPSHOT_OFFSET_TOTAL        1     // 총 대기 인원
+#define L3_SNAPSHOT_OFFSET_FIRSTPOS     2     // 세그먼트 첫 ID 의 순번 (1부터)
+#define L3_SNAPSHOT_OFFSET_COUNT        3     // 세그먼트에 담긴 ID 수
+#define L3_SNAPSHOT_OFFSET_BASE         4     // ID 기준값 (세그먼트 내 최소 ID)
+#define L3_SNAPSHOT_OFFSET_WIDTH        5     // ID 당 비트 수 (0~8)
+#define L3_SNAPSHOT_OFFSET_IDS          6     // 비트 패킹된 ID 시작 위치
+#define L3_SNAPSHOT_MAXSIZE             25    // 세그먼트 최대 크기 (L2 프레임 하나, L2_MSG_MAXDATASIZE 미만)
+
+// 예상 입장 시간 (BOOTH_ANNOUNCE / QUEUE_INFO 끝에 2바이트, 초 단위, 상위 바이트 먼저)
+#define L3_ETA_UNKNOWN                  0xFFFF // 예상 시간 없음 (구 형식 메시지)
+#define L3_ANNOUNCE_OFFSET_ETA          4     // BOOTH_ANNOUNCE 데이터 내 위치 (새 사용자 기준)
+#define L3_QUEUEINFO_OFFSET_ETA         2     // QUEUE_INFO 데이터 내 위치 (해당 순번 기준)
+
+// 부스 정적 정보(설명, 정원) 버전: 설명 내용으로 계산, 사용자는 부스 ID + 버전으로 설명을 캐시
+//   - BOOTH_ANNOUNCE 로 현재 버전을 알리고, CONNECT_REQUEST 에 캐시된 버전을 실어 보냄
+//   - 버전이 같으면 관리자는 설명을 뺀 BOOTH_INFO_SHORT 로 응답 (L2 조각 1개)
+#define L3_INFOVER_NONE                 0     // 버전 없음 (구 형식 메시지 / 캐시 없음)
+#define L3_ANNOUNCE_OFFSET_INFOVER      6     // BOOTH_ANNOUNCE 데이터 내 위치
+#define L3_CONNECT_OFFSET_INFOVER       0     // CONNECT_REQUEST 데이터 내 위치 (없으면 캐시 없음)
+#define L3_BOOTHINFO_OFFSET_DESC        3     // BOOTH_INFO 설명 시작 위치 (설명 널 종료 뒤에 버전 1바이트)
+#define L3_INFOSHORT_OFFSET_CURRENT     0     // BOOTH_INFO_SHORT: 현재 이용자 수
+#define L3_INFOSHORT_OFFSET_CAPACITY    1     // BOOTH_INFO_SHORT: 정원
+#define L3_INFOSHORT_OFFSET_WAITING     2     // BOOTH_INFO_SHORT: 대기 인원
+#define L3_INFOSHORT_OFFSET_INFOVER     3     // BOOTH_INFO_SHORT: 사용자 캐시와 일치한 버전
+
+// 요청 ID: 사용자가 연결/등록 시도마다 새로 정하고 재전송에는 같은 값을 씀
+//   - 관리자는 같은 ID 의 요청에 다시 처리하지 않고 캐시한 응답을 그대로 보냄 (L3_respCache)
+#define L3_REQID_NONE                   0     // 요청 ID 없음 (구 형식 메시지, 캐시하지 않음)
+#define L3_CONNECT_OFFSET_REQID         1     // CONNECT_REQUEST 데이터 내 위치 (정보 버전 뒤)
+#define L3_REGISTER_OFFSET_REQID        0     // REGISTER_REQUEST 데이터 내 위치
+#define L3_JOINREQ_OFFSET_REQID         0     // JOIN_REQUEST 데이터 내 위치
+
+// QUEUE_READY 데이터 필드 위치
+//   - 0 이면 바로 입장 (사용자가 REGISTER_REQUEST 전송)
+//   - 0 보다 크면 예약: 자리가 약 N초 뒤에 비므로 QUEUE_READY_ACK 로 미리 등록, 자리가 비면 관리자가 바로 입장 처리
+#define L3_QUEUEREADY_OFFSET_LEAD       0     // 자리가 빌 때까지 남은 시간 (초)
+
+// QUEUE_READY_ACK 데이터 필드 위치
+//   - 예약 호출에 대한 응답이면 사전 등록
+//   - 바로 입장 호출에 대한 응답이면 "아직 부스 근처가 아님" (가까워지면 REGISTER_REQUEST 로 확인)
+#define L3_READYACK_OFFSET_RSSI         0     // 사용자 측 평균 RSSI (dBm, int8)
+
+// KEEPALIVE 데이터 필드 위치
+//   - 관리자가 이미 정리한 사용자면 상태에 맞게 TIMEOUT_ALERT / QUEUE_UPDATE(제거) 로 알려줌
+#define L3_KEEPALIVE_OFFSET_STATE       0     // 사용자 FSM 상태 (L3STATE_IN_USE / L3STATE_WAITING)
+
+// FED_REGISTER 데이터 필드 위치 (발신 관리자 ID 가 체험한 부스)
+#define L3_FEDREG_OFFSET_USER           0     // 체험(등록)한 사용자 ID
+
+// REDIRECT_OFFER 데이터 필드 위치
+//   - 사용자가 받아들이면 지금 대기열을 떠나 (QUEUE_LEAVE) 안내된 부스에 연결
+#define L3_REDIRECT_OFFSET_BOOTH        0     // 안내하는 부스 ID
+#define L3_REDIRECT_OFFSET_ETA          1     // 그 부스의 예상 입장 시간 (초, 상위 바이트 먼저)
+
+// BUSY 데이터 필드 위치
+//   - 관리자가 요청 폭주로 지금 처리하지 않은 요청: 사용자는 재시도 타이머 대신 retry-after 뒤에 같은 요청 ID 로 다시 보냄
+#define L3_BUSY_OFFSET_REQTYPE          0     // 보류된 요청의 메시지 타입
+#define L3_BUSY_OFFSET_REQID            1     // 보류된 요청의 요청 ID
+#define L3_BUSY_OFFSET_RETRYMS          2     // 다시 보낼 때까지 기다릴 시간 (ms, 상위 바이트 먼저)
+
+// CHAT_COMPACT 데이터 필드 위치
+//   - 플래그 + (관리자 중계면 발신자 ID) + 압축한 문장 (널 종료 없음, 메시지 끝까지)
+#define L3_CHATC_OFFSET_FLAGS           0     // 플래그 (L3_CHATC_FLAG_*)
+#define L3_CHATC_OFFSET_SENDER          1     // 발신자 ID (L3_CHATC_FLAG_SENDER 일 때만)
+#define L3_CHATC_FLAG_SENDER            0x01  // 관리자가 중계한 메시지: 발신자 ID 포함
+#define L3_CHATC_FLAG_DICT              0x02  // 정적 사전 압축 (L3_chatCodec)
+#define L3_CHAT_MAXLEN                  100   // 채팅 문장 최대 길이 (널 종료 제외)
+
+// JOIN_RESPONSE 데이터 필드 위치 (REGISTER_RESPONSE + QUEUE_INFO 를 한 메시지로)
+//   - 순번/총 대기 인원/예상 시간은 REGISTER_REASON_FULL_WAITING 일 때만 의미 있음
+#define L3_JOIN_OFFSET_REASON           0     // 등록 응답 사유 코드 (REGISTER_REASON_*)
+#define L3_JOIN_OFFSET_POSITION         1     // 대기 순번
+#define L3_JOIN_OFFSET_TOTAL            2     // 총 대기 인원
+#define L3_JOIN_OFFSET_ETA              3     // 예상 입장 시간 (초, 상위 바이트 먼저)
+
+// BOOTH_SCAN 데이터 필드 위치 (없으면 구 형식: 관리자가 즉시 응답)
+//   - 관리자는 0 ~ nbSlots-1 중 임의의 슬롯을 골라 slot * slotLen 뒤에 응답
+#define L3_SCAN_OFFSET_NBSLOTS          0     // 응답 슬롯 수
+#define L3_SCAN_OFFSET_SLOTLEN          1     // 슬롯 길이 (10ms 단위)
+#define L3_SCAN_SLOTUNIT_MS             10    // 슬롯 길이 단위 (ms)
+
+// GROUP_DATA 데이터 필드 위치 (L3_msg_getData 기준)
+//   - 내부 메시지는 일반 L3 메시지 (CHAT_MESSAGE, ADMIN_MESSAGE 등) 그대로
+#define L3_GROUP_OFFSET_ID              0     // 그룹 ID (부스 ID)
+#define L3_GROUP_OFFSET_SEQ             1     // 그룹 시퀀스 번호
+#define L3_GROUP_OFFSET_LEN             2     // 내부 메시지 길이 (조각 유실로 잘못 재조립된 SDU 검출용)
+#define L3_GROUP_OFFSET_INNER           3     // 내부 메시지 시작 위치
+
+// GROUP_NACK 데이터 필드 위치
+//   - base 는 항상 빠진 번호, mask 의 i 번째 비트는 base + 1 + i 번도 빠졌음을 뜻함
+#define L3_GROUP_NACK_OFFSET_ID         0     // 그룹 ID
+#define L3_GROUP_NACK_OFFSET_BASE       1     // 첫 번째 빠진 시퀀스 번호
+#define L3_GROUP_NACK_OFFSET_MASK       2     // 이후 8개 번호의 유실 비트맵
+
 // 메시지 디코딩 함수
 uint8_t  L3_msg_getType(uint8_t* msg);     // 버퍼에서 타입 읽기
 uint8_t* L3_msg_getData(uint8_t* msg);     // 버퍼에서 데이터 시작 주소 얻기
+uint8_t  L3_msg_checkQueueSnapshot(uint8_t* msg, uint8_t size);      // 세그먼트 길이 확인 (정상이면 1)
+uint8_t  L3_msg_getQueueSnapshotId(uint8_t* msg, uint8_t index);     // 세그먼트의 index 번째 ID
+uint8_t  L3_msg_checkGroupData(uint8_t* msg, uint8_t size);          // 내부 메시지 길이 확인 (정상이면 1)
+uint16_t L3_msg_getEta(uint8_t* msg, uint8_t size, uint8_t offset);  // 데이터 offset 위치의 예상 시간 (없으면 L3_ETA_UNKNOWN)
+uint8_t  L3_msg_getInfoVersion(uint8_t* msg, uint8_t size, uint8_t offset); // 데이터 offset 위치의 정보 버전 (없으면 L3_INFOVER_NONE)
+uint8_t  L3_msg_getReqId(uint8_t* msg, uint8_t size, uint8_t offset);      // 데이터 offset 위치의 요청 ID (없으면 L3_REQID_NONE)
+uint8_t  L3_msg_getChatCompact(uint8_t* msg, uint8_t size, uint8_t* senderId, char* text, uint8_t textSize); // CHAT_COMPACT 복원 (정상이면 1, 발신자 없으면 0)
+uint8_t  L3_msg_getBoothInfoVersion(uint8_t* msg, uint8_t size);    // BOOTH_INFO 설명 뒤의 정보 버전
+uint8_t  L3_msg_infoVersion(uint8_t capacity, const char* description); // 부스 정적 정보 버전 계산
 
 // 메시지 인코딩 함수 선언
 uint8_t L3_msg_encodeUserInfoRequest(uint8_t* msg);
-uint8_t L3_msg_encodeConnectRequest(uint8_t* msg, uint8_t userId);
+uint8_t L3_msg_encodeBoothScan(uint8_t* msg, uint8_t nbSlots, uint16_t slotMs);
+uint8_t L3_msg_encodeConnectRequest(uint8_t* msg, uint8_t cachedInfoVersion, uint8_t reqId);
 uint8_t L3_msg_encodeBoothInfo(uint8_t* msg,
                                uint8_t currentCount,
                                uint8_t capacity,
                                uint8_t waitingCount,
-                               const char* description);
+                               const char* description,
+                               uint8_t infoVersion);
+uint8_t L3_msg_encodeBoothInfoShort(uint8_t* msg,
+                                    uint8_t currentCount,
+                                    uint8_t capacity,
+                                    uint8_t waitingCount,
+                                    uint8_t infoVersion);
 uint8_t L3_msg_encodeUserResponse(uint8_t* msg, uint8_t response);
 uint8_t L3_msg_encodeRegisterResponse(uint8_t* msg,
                                       uint8_t success,
                                       uint8_t reason);
+uint8_t L3_msg_encodeQueueReady(uint8_t* msg, uint8_t leadSec);
+uint8_t L3_msg_encodeKeepalive(uint8_t* msg, uint8_t state);
+uint8_t L3_msg_encodeFedRegister(uint8_t* msg, uint8_t userId);
+uint8_t L3_msg_encodeRedirectOffer(uint8_t* msg, uint8_t boothId, uint16_t etaSec);
+uint8_t L3_msg_encodeBusy(uint8_t* msg, uint8_t reqType, uint8_t reqId, uint16_t retryMs);
 uint8_t L3_msg_encodeQueueInfo(uint8_t* msg,
                                uint8_t queueNumber,
-                               uint8_t totalWaiting);
+                               uint8_t totalWaiting,
+                               uint16_t etaSec);
+uint8_t L3_msg_encodeJoinResponse(uint8_t* msg,
+                                  uint8_t reason,
+                                  uint8_t queueNumber,
+                                  uint8_t totalWaiting,
+                                  uint16_t etaSec);
 uint8_t L3_msg_encodeBoothAnnounce(uint8_t* msg,
                                    uint8_t boothId,
                                    uint8_t currentCount,
                                    uint8_t capacity,
-                                   uint8_t waitingCount);
+                                   uint8_t waitingCount,
+                                   uint16_t etaSec,
+                                   uint8_t infoVersion);
 uint8_t L3_msg_encodeAdminMessage(uint8_t* msg, const char* message);
 uint8_t L3_msg_encodeChatMessage(uint8_t* msg, const char* message);
 uint8_t L3_msg_encodeChatMessageWithSender(uint8_t* msg,
                                            uint8_t senderId,
                                            const char* message);
+uint8_t L3_msg_encodeQueueSnapshot(uint8_t* msg,
+                                   uint8_t version,
+                                   uint8_t totalWaiting,
+                                   uint8_t firstPosition,
+                                   const uint8_t* userIds,
+                                   uint8_t count,
+                                   uint8_t* nbEncoded);
+uint8_t L3_msg_encodeGroupData(uint8_t* msg,
+                               uint8_t groupId,
+                               uint8_t seq,
+                               const uint8_t* inner,
+                               uint8_t innerLen);
+uint8_t L3_msg_encodeGroupNack(uint8_t* msg,
+                               uint8_t groupId,
+                               uint8_t baseSeq,
+                               uint8_t mask);
 
 #endif // L3_MSG_H
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "mbed.h"
+#include "L3_msgHandler.h"
+#include "protocol_parameters.h"
+
+// 이 노드의 역할
+static uint8_t myRole = L3ROLE_USER;
+
+// 상태 x 메시지 타입 핸들러 테이블 (이 노드의 역할만 보관)
+static L3_msgHandler_t handlerTable[L3STATE_NB][L3_MSG_TYPE_NB];
+
+// 이 역할이 어느 상태에서든 처리하는 타입인지 여부 (UNEXPECTED / DROPPED 구분용)
+static uint8_t isKnownType[L3_MSG_TYPE_NB];
+
+// 메시지 타입별 통계
+static uint32_t handledCnt[L3_MSG_TYPE_NB];
+static uint32_t unexpectedCnt[L3_MSG_TYPE_NB];
+static uint32_t droppedCnt[L3_MSG_TYPE_NB];
+static uint32_t invalidCnt = 0;     // 범위를 벗어난 타입 (또는 상태)
+
+
+void L3_handler_init(uint8_t role)
+{
+    myRole = role;
+
+    for (uint8_t s = 0; s < L3STATE_NB; s++)
+    {
+        for (uint8_t t = 0; t < L3_MSG_TYPE_NB; t++)
+        {
+            handlerTable[s][t] = NULL;
+        }
+    }
+
+    for (uint8_t t = 0; t < L3_MSG_TYPE_NB; t++)
+    {
+        isKnownType[t] = 0;
+    }
+
+    L3_handler_resetStats();
+}
+
+uint8_t L3_handler_register(uint8_t role, uint8_t state, uint8_t msgType, L3_msgHandler_t handler)
+{
+    // 다른 역할의 핸들러는 테이블에 넣지 않음
+    if (role != myRole)
+    {
+        return 0;
+    }
+
+    if (msgType == 0 || msgType >= L3_MSG_TYPE_NB ||
+        (state != L3_HANDLER_STATE_ANY && state >= L3STATE_NB))
+    {
+        debug("[L3][WARNING] Invalid handler registration (state %i, type 0x%02X)\n", state, msgType);
+        return 0;
+    }
+
+    for (uint8_t s = 0; s < L3STATE_NB; s++)
+    {
+        if (state == L3_HANDLER_STATE_ANY || state == s)
+        {
+            handlerTable[s][msgType] = handler;
+        }
+    }
+    isKnownType[msgType] = 1;
+
+    return 1;
+}
+
+uint8_t L3_handler_dispatch(uint8_t state, uint8_t srcId, uint8_t* msg, uint8_t size, int16_t rssi)
+{
+    uint8_t msgType = L3_msg_getType(msg);
+
+    if (msgType >= L3_MSG_TYPE_NB || state >= L3STATE_NB)
+    {
+        invalidCnt++;
+        debug_if(DBGMSG_L3, "[L3] Dropped unknown message type 0x%02X from %i\n", msgType, srcId);
+        return L3_HANDLER_DROPPED;
+    }
+
+    L3_msgHandler_t handler = handlerTable[state][msgType];
+    if (handler != NULL)
+    {
+        handledCnt[msgType]++;
+        handler(srcId, msg, size, rssi);
+        return L3_HANDLER_HANDLED;
+    }
+
+    if (isKnownType[msgType])
+    {
+        unexpectedCnt[msgType]++;
+        debug_if(DBGMSG_L3, "[L3] Unexpected message type 0x%02X from %i in state %i\n", msgType, srcId, state);
+        return L3_HANDLER_UNEXPECTED;
+    }
+
+    droppedCnt[msgType]++;
+    debug_if(DBGMSG_L3, "[L3] Dropped message type 0x%02X from %i (not handled by this role)\n", msgType, srcId);
+    return L3_HANDLER_DROPPED;
+}
+
+uint32_t L3_handler_getHandledCount(uint8_t msgType)
+{
+    return (msgType < L3_MSG_TYPE_NB) ? handledCnt[msgType] : 0;
+}
+
+uint32_t L3_handler_getUnexpectedCount(uint8_t msgType)
+{
+    return (msgType < L3_MSG_TYPE_NB) ? unexpectedCnt[msgType] : 0;
+}
+
+uint32_t L3_handler_getDroppedCount(uint8_t msgType)
+{
+    return (msgType < L3_MSG_TYPE_NB) ? droppedCnt[msgType] : 0;
+}
+
+uint32_t L3_handler_getInvalidCount(void)
+{
+    return invalidCnt;
+}
+
+void L3_handler_resetStats(void)
+{
+    invalidCnt = 0;
+    for (uint8_t t = 0; t < L3_MSG_TYPE_NB; t++)
+    {
+        handledCnt[t] = 0;
+        unexpectedCnt[t] = 0;
+        droppedCnt[t] = 0;
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef L3_MSGHANDLER_H
+#define L3_MSGHANDLER_H
+
+#include "mbed.h"
+#include "L3_msg.h"
+#include "L3_types.h"
+
+// 수신 메시지 핸들러: 발신자 ID, 메시지 버퍼(타입 포함), 메시지 길이, RSSI
+typedef void (*L3_msgHandler_t)(uint8_t srcId, uint8_t* msg, uint8_t size, int16_t rssi);
+
+// 모든 상태에 등록할 때 사용하는 상태 값
+#define L3_HANDLER_STATE_ANY            0xFF
+
+// 디스패치 결과
+#define L3_HANDLER_HANDLED              0     // 핸들러 실행됨
+#define L3_HANDLER_UNEXPECTED           1     // 이 역할이 처리하는 타입이지만 현재 상태에서는 처리 안 함
+#define L3_HANDLER_DROPPED              2     // 이 역할이 처리하지 않는 타입 (또는 알 수 없는 타입)
+
+// 레지스트리 초기화: 이 노드의 역할에 해당하는 등록만 테이블에 반영됨
+void L3_handler_init(uint8_t role);
+
+// (역할, 상태, 메시지 타입) -> 핸들러 등록, 성공 시 1 반환
+uint8_t L3_handler_register(uint8_t role, uint8_t state, uint8_t msgType, L3_msgHandler_t handler);
+
+// 현재 상태 기준으로 수신 메시지를 핸들러로 전달 (테이블 한 번 조회)
+uint8_t L3_handler_dispatch(uint8_t state, uint8_t srcId, uint8_t* msg, uint8_t size, int16_t rssi);
+
+// 메시지 타입별 통계
+uint32_t L3_handler_getHandledCount(uint8_t msgType);
+uint32_t L3_handler_getUnexpectedCount(uint8_t msgType);
+uint32_t L3_handler_getDroppedCount(uint8_t msgType);
+uint32_t L3_handler_getInvalidCount(void);     // L3_MSG_TYPE_NB 이상의 알 수 없는 타입
+void L3_handler_resetStats(void);
+
+#endif // L3_MSGHANDLER_H
@@ -0,0 +1,57 @@
+#include "mbed.h"
+#include "L3_registry.h"
+
+// uint8_t ID 공간 전체 (256개)를 덮는 등록 비트맵
+#define L3_REGISTRY_IDSPACE     256
+
+static uint32_t registryBitmap[L3_REGISTRY_IDSPACE / 32];
+
+// 등록 기록: ID 당 최대 한 번 등록되므로 ID 공간 크기면 넘치지 않음
+static L3_registryRecord_t registryRecords[L3_REGISTRY_IDSPACE];
+static uint16_t registryCount = 0;
+
+
+void L3_registry_init(void)
+{
+    for (uint8_t i = 0; i < L3_REGISTRY_IDSPACE / 32; i++)
+    {
+        registryBitmap[i] = 0;
+    }
+    registryCount = 0;
+}
+
+uint8_t L3_registry_contains(uint8_t userId)
+{
+    return (registryBitmap[userId >> 5] >> (userId & 0x1F)) & 0x01;
+}
+
+uint8_t L3_registry_add(uint8_t userId, uint32_t checkInTime)
+{
+    if (L3_registry_contains(userId))
+    {
+        return 0;
+    }
+
+    registryBitmap[userId >> 5] |= ((uint32_t)0x01 << (userId & 0x1F));
+
+    registryRecords[registryCount].userId = userId;
+    registryRecords[registryCount].checkInTime = checkInTime;
+    registryCount++;
+
+    return 1;
+}
+
+uint16_t L3_registry_getCount(void)
+{
+    return registryCount;
+}
+
+const L3_registryRecord_t* L3_registry_getRecord(uint16_t index)
+{
+    if (index >= registryCount)
+    {
+        return NULL;
+    }
+
+    return &registryRecords[index];
+}
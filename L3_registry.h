@@ -0,0 +1,27 @@
+#ifndef L3_REGISTRY_H
+#define L3_REGISTRY_H
+
+#include "mbed.h"
+
+// 부스 체험 기록 (등록 순서대로 저장)
+typedef struct {
+    uint8_t userId;           // 사용자 ID
+    uint32_t checkInTime;     // 체크인(등록) 시각 (ms, L3_timer_getMs 기준)
+} L3_registryRecord_t;
+
+// 레지스트리 초기화 (모든 기록 삭제)
+void L3_registry_init(void);
+
+// 이미 체험한 사용자인지 확인 (비트맵 조회, O(1))
+uint8_t L3_registry_contains(uint8_t userId);
+
+// 사용자 등록, 새로 등록되면 1 / 이미 등록된 사용자면 0 반환
+uint8_t L3_registry_add(uint8_t userId, uint32_t checkInTime);
+
+// 총 등록된 사용자 수
+uint16_t L3_registry_getCount(void);
+
+// index 번째로 등록된 사용자 기록 (범위 밖이면 NULL)
+const L3_registryRecord_t* L3_registry_getRecord(uint16_t index);
+
+#endif // L3_REGISTRY_H
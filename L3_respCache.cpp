@@ -0,0 +1,74 @@
+#include "mbed.h"
+#include "L3_respCache.h"
+#include "protocol_parameters.h"
+
+typedef struct {
+    uint8_t userId;                       // 사용자 ID (0 : 빈 항목)
+    uint8_t reqType;                      // 요청 메시지 타입
+    uint8_t reqId;                        // 요청 ID
+    uint8_t size;                         // 응답 길이
+    uint32_t storeTime;                   // 저장 시각 (ms)
+    uint8_t msg[L3_RESPCACHE_MSGSIZE];    // 응답 메시지
+} L3_respCacheEntry_t;
+
+static L3_respCacheEntry_t entries[L3_RESPCACHE_SIZE];
+
+
+void L3_respCache_init(void)
+{
+    for (uint8_t i = 0; i < L3_RESPCACHE_SIZE; i++)
+    {
+        entries[i].userId = 0;
+    }
+}
+
+const uint8_t* L3_respCache_find(uint8_t userId, uint8_t reqType, uint8_t reqId,
+                                 uint32_t now, uint32_t maxAgeMs, uint8_t *size)
+{
+    for (uint8_t i = 0; i < L3_RESPCACHE_SIZE; i++)
+    {
+        if (entries[i].userId == userId && entries[i].reqType == reqType)
+        {
+            if (entries[i].reqId != reqId || now - entries[i].storeTime > maxAgeMs)
+            {
+                return NULL;
+            }
+
+            *size = entries[i].size;
+            return entries[i].msg;
+        }
+    }
+    return NULL;
+}
+
+void L3_respCache_store(uint8_t userId, uint8_t reqType, uint8_t reqId,
+                        const uint8_t *msg, uint8_t size, uint32_t now)
+{
+    if (size > L3_RESPCACHE_MSGSIZE)
+    {
+        return;
+    }
+
+    // 같은 사용자/요청 타입 항목, 없으면 빈 항목, 그것도 없으면 가장 오래된 항목
+    L3_respCacheEntry_t *slot = NULL;
+    for (uint8_t i = 0; i < L3_RESPCACHE_SIZE; i++)
+    {
+        if (entries[i].userId == userId && entries[i].reqType == reqType)
+        {
+            slot = &entries[i];
+            break;
+        }
+        if (slot == NULL || (slot->userId != 0 &&
+            (entries[i].userId == 0 || now - entries[i].storeTime > now - slot->storeTime)))
+        {
+            slot = &entries[i];
+        }
+    }
+
+    slot->userId = userId;
+    slot->reqType = reqType;
+    slot->reqId = reqId;
+    slot->size = size;
+    slot->storeTime = now;
+    memcpy(slot->msg, msg, size);
+}
@@ -0,0 +1,21 @@
+#ifndef L3_RESPCACHE_H
+#define L3_RESPCACHE_H
+
+#include "mbed.h"
+
+// 요청 응답 캐시 (관리자 측)
+//   - 사용자 재전송 요청 (같은 요청 ID) 은 핸들러를 다시 실행하지 않고 저장된 응답을 그대로 다시 보냄
+//   - 사용자/요청 타입마다 마지막 응답 하나만 보관
+
+// 캐시 초기화
+void L3_respCache_init(void);
+
+// 같은 사용자, 요청 타입, 요청 ID 의 응답이 maxAgeMs 안에 저장되어 있으면 응답 (없으면 NULL)
+const uint8_t* L3_respCache_find(uint8_t userId, uint8_t reqType, uint8_t reqId,
+                                 uint32_t now, uint32_t maxAgeMs, uint8_t *size);
+
+// 응답 저장 (같은 사용자/요청 타입의 이전 응답은 대체, 가득 차면 가장 오래된 항목 대체)
+void L3_respCache_store(uint8_t userId, uint8_t reqType, uint8_t reqId,
+                        const uint8_t *msg, uint8_t size, uint32_t now);
+
+#endif // L3_RESPCACHE_H
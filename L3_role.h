@@ -0,0 +1,58 @@
+#ifndef L3_ROLE_H
+#define L3_ROLE_H
+
+#include "mbed.h"
+#include "L3_msg.h"
+#include "L3_types.h"
+
+// 역할별 펌웨어 이미지 선택 (Makefile: make ROLE=admin | ROLE=user, 기본값은 두 역할 모두 포함)
+//   - 단일 역할 이미지는 다른 역할의 코드/데이터(L3_admin.o 또는 L3_user.o)를 링크하지 않음
+//   - L3_ROLE_HAS_xxx 가 상수이므로 역할 분기는 컴파일 시 제거됨
+#if defined(L3_ROLE_ADMIN_ONLY) && defined(L3_ROLE_USER_ONLY)
+#error "L3_ROLE_ADMIN_ONLY and L3_ROLE_USER_ONLY are exclusive"
+#elif defined(L3_ROLE_ADMIN_ONLY)
+#define L3_ROLE_HAS_ADMIN               1
+#define L3_ROLE_HAS_USER                0
+#elif defined(L3_ROLE_USER_ONLY)
+#define L3_ROLE_HAS_ADMIN               0
+#define L3_ROLE_HAS_USER                1
+#else
+#define L3_ROLE_HAS_ADMIN               1
+#define L3_ROLE_HAS_USER                1
+#endif
+
+// 세션 타이머 설정 (관리자/사용자 공통)
+#define SESSION_DURATION_MS             120000  // 세션 당 120초 (변경 가능)
+#define QUEUE_READY_TIMEOUT_MS          10000   // 큐 준비 응답 대기 10초
+#define ADMISSION_LEAD_MS               15000   // 세션 종료 15초 전에 다음 대기자 예약 호출 (0 : 사용 안 함)
+
+// ID로 역할 판별: 단일 역할 이미지에서는 ID와 무관하게 이미지의 역할로 고정
+static inline uint8_t L3_role_fromId(uint8_t id)
+{
+#if L3_ROLE_HAS_ADMIN && L3_ROLE_HAS_USER
+    return (id >= ADMIN_ID_START && id <= ADMIN_ID_END) ? L3ROLE_ADMIN : L3ROLE_USER;
+#elif L3_ROLE_HAS_ADMIN
+    return L3ROLE_ADMIN;
+#else
+    return L3ROLE_USER;
+#endif
+}
+
+#if L3_ROLE_HAS_ADMIN
+// 관리자(부스) 역할 진입점 - L3_admin.cpp
+void L3admin_init(uint8_t id);
+void L3admin_registerHandlers(void);
+void L3admin_run(void);
+uint8_t L3admin_getState(void);
+#endif
+
+#if L3_ROLE_HAS_USER
+// 사용자 역할 진입점 - L3_user.cpp
+void L3service_init(uint8_t id);
+void L3service_registerHandlers(void);
+void L3service_run(void);
+uint8_t L3service_getState(void);
+void L3service_onDataCnf(uint8_t handle, uint8_t res); // 요청별 전송 결과 (L2 DATA_CNF)
+#endif
+
+#endif // L3_ROLE_H
@@ -10,6 +10,11 @@ static uint8_t timerStatus = 0;
 static Timeout boothSelectionTimer;
 static uint8_t boothSelectionTimerStatus = 0;
 
+// ms 시계 (us_ticker 의 32bit wrap 을 누적해서 보정)
+static uint32_t msClock = 0;
+static uint32_t msClockLastUs = 0;
+static uint32_t msClockRemainderUs = 0;
+
 
 // 타이머 만료 핸들러: ARQ 타임아웃
 void L3_timer_timeoutHandler(void) 
@@ -46,10 +51,10 @@ uint8_t L3_timer_getTimerStatus()
     return timerStatus;
 }
 
-// 부스 선택 타이머 시작
-void L3_timer_boothSelectionStart()
+// 부스 선택 타이머 시작 (스캔 응답 창이 끝나는 시점)
+void L3_timer_boothSelectionStart(uint32_t timeoutMs)
 {
-    boothSelectionTimer.attach(L3_timer_boothSelectionHandler, 10.0);  // 10초 후 타임아웃
+    boothSelectionTimer.attach_us(L3_timer_boothSelectionHandler, timeoutMs * 1000);
     boothSelectionTimerStatus = 1;
 }
 
@@ -59,3 +64,19 @@ void L3_timer_boothSelectionStop()
     boothSelectionTimer.detach();
     boothSelectionTimerStatus = 0;
 }
+
+// 현재 시각 (ms), us_ticker_read()/1000 과 달리 71분마다 튀지 않음
+// 최소 71분에 한 번은 호출되어야 함 (L3_FSMrun 에서 매 루프 호출됨)
+uint32_t L3_timer_getMs()
+{
+    core_util_critical_section_enter();
+    uint32_t nowUs = us_ticker_read();
+    uint32_t elapsedUs = (nowUs - msClockLastUs) + msClockRemainderUs;
+    msClockLastUs = nowUs;
+    msClock += elapsedUs / 1000;
+    msClockRemainderUs = elapsedUs % 1000;
+    uint32_t now = msClock;
+    core_util_critical_section_exit();
+
+    return now;
+}
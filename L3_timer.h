@@ -2,5 +2,6 @@
 void L3_timer_startTimer();
 void L3_timer_stopTimer();
 uint8_t L3_timer_getTimerStatus();
-void L3_timer_boothSelectionStart(); 
-void L3_timer_boothSelectionStop();   
\ No newline at end of file
+void L3_timer_boothSelectionStart(uint32_t timeoutMs);
+void L3_timer_boothSelectionStop();
+uint32_t L3_timer_getMs();   
\ No newline at end of file
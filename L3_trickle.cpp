@@ -0,0 +1,75 @@
+#include "mbed.h"
+#include "L3_trickle.h"
+#include "L2_backoff.h"
+#include "protocol_parameters.h"
+
+static uint32_t intervalMs = L3_ANNOUNCE_IMINMS;  // 현재 간격 I
+static uint32_t intervalStart = 0;                // 현재 간격 시작 시각 (ms)
+static uint32_t fireOffset = 0;                   // 간격 안에서 방송할 시점 t (ms)
+static uint8_t counter = 0;                       // 이번 간격에 나간 같은 내용의 방송 수 c
+static uint8_t isFired = 0;                       // 이번 간격의 방송 시점을 지났는지
+
+
+// 새 간격 시작: 방송 시점은 [I/2, I) 에서 임의로
+static void startInterval(uint32_t now)
+{
+    intervalStart = now;
+    fireOffset = intervalMs / 2 + L2_backoff_randRange(intervalMs / 2);
+    counter = 0;
+    isFired = 0;
+}
+
+void L3_trickle_init(uint32_t now)
+{
+    intervalMs = L3_ANNOUNCE_IMINMS;
+    startInterval(now);
+}
+
+void L3_trickle_reset(uint32_t now)
+{
+    // 이전 내용의 방송 수는 새 내용과 무관
+    counter = 0;
+
+    // 최소 간격이고 아직 방송 시점 전이면 그 시점에 새 내용이 나감 (다시 시작하면 더 늦어짐)
+    if (intervalMs == L3_ANNOUNCE_IMINMS && !isFired)
+    {
+        return;
+    }
+
+    intervalMs = L3_ANNOUNCE_IMINMS;
+    startInterval(now);
+}
+
+void L3_trickle_hear(void)
+{
+    if (counter < 0xFF)
+    {
+        counter++;
+    }
+}
+
+uint8_t L3_trickle_poll(uint32_t now)
+{
+    uint32_t elapsed = now - intervalStart;
+
+    if (elapsed >= intervalMs)
+    {
+        // 간격 끝: 두 배로 늘려 (최대 간격까지) 다음 간격 시작
+        intervalMs = (intervalMs * 2 > L3_ANNOUNCE_IMAXMS) ? L3_ANNOUNCE_IMAXMS : intervalMs * 2;
+        startInterval(now);
+        return 0;
+    }
+
+    if (isFired || elapsed < fireOffset)
+    {
+        return 0;
+    }
+
+    isFired = 1;
+    return counter < L3_ANNOUNCE_K;
+}
+
+uint32_t L3_trickle_getIntervalMs(void)
+{
+    return intervalMs;
+}
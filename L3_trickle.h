@@ -0,0 +1,26 @@
+#ifndef L3_TRICKLE_H
+#define L3_TRICKLE_H
+
+#include "mbed.h"
+
+// Trickle 방송 간격 (관리자 BOOTH_ANNOUNCE)
+//   - 상태가 바뀌면 최소 간격부터 다시 시작, 안정되면 간격을 두 배씩 늘려 최대 간격까지
+//   - 간격마다 [I/2, I) 의 임의 시점에 한 번 방송, 그 간격 안에 같은 방송이 이미 k 번 나갔으면 생략
+
+// 초기화: 최소 간격부터 시작
+void L3_trickle_init(uint32_t now);
+
+// 방송 내용이 바뀜: 같은 내용 방송 수를 비우고 최소 간격부터 다시 시작
+//   (이미 최소 간격이고 이번 간격의 방송 시점 전이면 그 시점에 방송)
+void L3_trickle_reset(uint32_t now);
+
+// 같은 내용의 방송이 (다른 경로로) 이미 나감: 이번 간격의 방송 생략 판단에 반영
+void L3_trickle_hear(void);
+
+// 지금 방송해야 하면 1 (간격이 끝나면 다음 간격으로 넘어감)
+uint8_t L3_trickle_poll(uint32_t now);
+
+// 현재 간격 (ms, 상태 출력용)
+uint32_t L3_trickle_getIntervalMs(void);
+
+#endif // L3_TRICKLE_H
@@ -4,6 +4,17 @@
 #include "mbed.h"
 #include "L3_msg.h"
 
+// FSM 상태 정의
+#define L3STATE_SCANNING    0
+#define L3STATE_CONNECTED   1
+#define L3STATE_WAITING     2
+#define L3STATE_IN_USE      3
+#define L3STATE_NB          4     // 상태 개수
+
+// 노드 역할 정의
+#define L3ROLE_USER         0     // 일반 사용자
+#define L3ROLE_ADMIN        1     // 관리자(부스)
+
 // 사용자 정보 구조체
 typedef struct {
     uint8_t userId;           // 사용자 ID
@@ -12,30 +23,51 @@ typedef struct {
     uint8_t waitingNumber;    // 대기 순번
     uint32_t checkInTime;     // 체크인(등록) 시각
     uint32_t sessionStartTime;// 세션 시작 시각
+    uint32_t lastSeenTime;    // 마지막으로 메시지를 받은 시각 (ms, L3_timer_getMs 기준, 무응답 정리용)
 } User_t;
 
 // 스캔용 부스 정보 구조체 (신규)
 typedef struct {
     uint8_t boothId;          // 부스 ID
-    int16_t rssi;             // 수신 신호 세기(RSSI)
+    int16_t rssi;             // 수신 신호 세기(RSSI), 마지막 샘플
+    int32_t rssiAvg;          // RSSI 이동 평균 (L3_boothScore 가 관리, 고정소수점)
+    uint8_t rssiSamples;      // 평균에 반영된 샘플 수 (255 에서 멈춤)
     uint8_t currentCount;     // 현재 부스 이용자 수
     uint8_t capacity;         // 부스 정원(최대 수용 인원)
     uint8_t waitingCount;     // 대기열 인원 수
-    uint32_t lastSeenTime;    // 마지막으로 스캔된 시각(타임아웃 용)
+    uint16_t etaSec;          // 부스가 알려준 예상 입장 시간 (초, L3_ETA_UNKNOWN : 모름)
+    uint32_t lastSeenTime;    // 마지막으로 방송을 들은 시각 (ms, L3_timer_getMs 기준)
     uint8_t isValid;          // 유효 항목 여부 플래그
+    uint8_t isVisited;        // 이미 체험한 부스 (다음 선택에서 제외)
 } BoothScanInfo_t;
 
+// 사용자 측 부스 설명 캐시 (부스 ID + 정보 버전으로 유효성 판단)
+typedef struct {
+    uint8_t boothId;                      // 부스 ID
+    uint8_t infoVersion;                  // 캐시한 정보 버전 (L3_INFOVER_NONE : 빈 항목)
+    uint8_t isAccepted;                   // 이 버전의 설명을 보고 체험에 동의함 ('y', 다음 연결은 빠른 입장)
+    char description[L3_BOOTH_DESCSIZE];  // 부스 설명 문자열
+} BoothInfoCache_t;
+
+// 사용자 측 가상 대기표: 지금 대기 중인 부스 외에 함께 줄 서 있는 부스
+typedef struct {
+    uint8_t boothId;          // 부스 ID (0 : 빈 항목)
+    uint8_t position;         // 대기 순번 (0 : JOIN_REQUEST 응답 대기 중)
+    uint8_t reqId;            // JOIN_REQUEST 요청 ID (재전송에도 같은 값)
+    uint8_t isDeferred;       // 관리자가 BUSY 로 재전송을 미루게 함
+    uint32_t resendTime;      // BUSY 가 알려준 JOIN_REQUEST 재전송 시각 (ms)
+    uint8_t totalWaiting;     // 총 대기 인원
+    uint16_t etaSec;          // 예상 입장 시간 (초)
+} VirtualTicket_t;
+
 // 부스 정보 구조체
 typedef struct {
     uint8_t boothId;                      // 부스 ID
     uint8_t capacity;                     // 부스 정원
     uint8_t currentCount;                 // 현재 이용자 수
-    uint8_t waitingCount;                 // 대기열 인원 수
-    char description[50];                 // 부스 설명 문자열
-    User_t registeredList[MAX_USERS];     // 등록된 사용자 정보 목록(영구 기록)
-    uint8_t registeredUserIds[MAX_USERS]; // 등록된 사용자 ID 배열
+    char description[L3_BOOTH_DESCSIZE];  // 부스 설명 문자열
     User_t activeList[MAX_BOOTH_CAPACITY];// 활성 사용자 정보 목록
-    User_t waitingQueue[MAX_USERS];       // 대기열 사용자 정보 목록
+    // 대기열은 L3_waitQueue 모듈이 관리
 } Booth_t;
 
 #endif // L3_TYPES_H
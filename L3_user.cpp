@@ -0,0 +1,2036 @@
+// L3_user.cpp - 사용자 역할
+#include "L3_FSMevent.h"
+#include "L3_msg.h"
+#include "L3_msgHandler.h"
+#include "L3_role.h"
+#include "L3_types.h"
+#include "L3_timer.h"
+#include "L3_deferred.h"
+#include "L3_group.h"
+#include "L3_boothScore.h"
+#include "L3_LLinterface.h"
+#include "L2_backoff.h"
+#include "protocol_parameters.h"
+#include "mbed.h"
+
+// 상태 변수
+static uint8_t main_state = L3STATE_SCANNING;  // 현재 FSM 상태
+static uint8_t prev_state = main_state;       // 이전 FSM 상태 (디버깅 용)
+
+// 사용자 및 부스 관리 (대기열 중복 메시지 필터링을 위한 변수)
+static uint8_t lastQueuePosition = 0;  // 마지막 받은 대기열 위치
+static uint8_t lastTotalWaiting = 0;   // 마지막 받은 총 대기 사용자 수
+
+// User and Booth Management
+static uint8_t myId;                  // 현재 사용자의 ID
+static uint8_t currentBoothId = 0;    // 현재 연결된 부스 ID (0 : 미연결)
+
+// 세션 타이머 관련 변수
+static uint32_t sessionStartTime = 0;    // 사용자 세션 시작 시간 기록 (ms)
+static uint8_t isSessionActive = 0;      // 사용자 측 세션 활성 상태 플래그
+
+// 대기열 관리 변수
+static uint8_t myWaitingNumber = 0;      // 사용자 대기열 순번 (사용자 측)
+static uint8_t totalWaitingUsers = 0;    // 대기 중인 총 사용자 수 (사용자 측)
+static uint16_t myEtaSec = L3_ETA_UNKNOWN;  // 부스가 알려준 예상 입장 시간 (초)
+static uint8_t lastSnapshotVersion = 0;  // 마지막으로 반영한 대기열 스냅샷 버전
+static uint8_t hasSnapshotVersion = 0;   // 현재 대기열에서 스냅샷을 받은 적 있는지
+static uint8_t isReserved = 0;           // 세션 종료 전 예약 호출을 받고 미리 등록함 (자리가 비면 자동 입장)
+static uint32_t reservationDeadline = 0; // 이 시각까지 입장 응답이 없으면 직접 REGISTER_REQUEST (ms)
+static uint8_t isFarNotified = 0;        // 입장 호출 중 "아직 멀리 있음" 을 이미 알렸는지
+static uint8_t isCallRegistering = 0;    // 입장 호출 (QUEUE_READY / 예약) 로 보낸 REGISTER_REQUEST 의 응답 대기 중
+static uint32_t lastKeepaliveTime = 0;   // 마지막 KEEPALIVE 전송 시각 (ms)
+static uint8_t offerBoothId = 0;         // 대기 중인 부스가 안내한 다른 부스 (0 : 안내 없음)
+static uint8_t isOfferAccepted = 0;      // 안내를 받아들임 ('x' 또는 빠른 입장), 메인 루프에서 이동
+
+// 가상 대기표: 대기 중에 다른 부스 대기열에도 함께 줄 섬, 먼저 부른 (QUEUE_READY) 부스로 감
+static uint8_t isTicketMode = 0;                    // 가상 대기표 모드 ('v' 로 전환)
+static VirtualTicket_t tickets[L3_TICKET_MAX];      // 다른 부스 대기표
+static uint8_t nbTickets = 0;                       // 사용 중인 대기표 수
+
+
+static uint8_t connectRetryCount = 0;    // 연결 재시도 카운터 (사용자 측)
+static uint8_t isWaitingForBoothInfo = 0; // 부스 정보 응답 대기 중인지 플래그
+static uint8_t connectReqHandle = 0;      // 전송 중인 CONNECT_REQUEST 의 L2 요청 핸들
+static uint8_t connectReqId = L3_REQID_NONE; // 현재 연결 시도의 요청 ID (재시도는 같은 ID)
+static uint32_t connectRetryTime = 0;     // 이 시각까지 응답이 없으면 연결 재시도 (ms, 타임아웃 + 지터 백오프)
+static uint8_t isConnectDeferred = 0;     // 관리자가 BUSY 로 재전송을 미루게 함 (응답 타임아웃 대신 재전송 시각까지 대기)
+static uint32_t connectResendTime = 0;    // BUSY 가 알려준 연결 요청 재전송 시각 (ms)
+
+// 빠른 입장 (JOIN): 연결 + 등록 의사를 한 번에 보내고 JOIN_RESPONSE 하나로 결과 수신
+static uint8_t autoJoin = 0;              // 사전 동의: 부스 정보 확인 없이 바로 입장 요청 ('j' 로 전환)
+static uint8_t isJoinRequest = 0;         // 현재 연결 시도가 JOIN_REQUEST 인지 (아니면 CONNECT_REQUEST)
+
+// 등록 요청 관련 변수 추가
+static uint8_t registerRetryCount = 0;    // 등록 재시도 카운터
+static uint8_t isWaitingForRegisterResponse = 0; // 등록 응답 대기 중인지 플래그
+static uint8_t registerReqHandle = 0;     // 전송 중인 REGISTER_REQUEST 의 L2 요청 핸들
+static uint8_t registerReqId = L3_REQID_NONE; // 현재 등록 시도의 요청 ID (재시도는 같은 ID)
+static uint8_t lastReqId = L3_REQID_NONE;     // 마지막으로 정한 요청 ID
+static uint32_t registerRetryTime = 0;    // 이 시각까지 응답이 없으면 등록 재시도 (ms, 타임아웃 + 지터 백오프)
+static uint8_t isRegisterDeferred = 0;    // 관리자가 BUSY 로 재전송을 미루게 함
+static uint32_t registerResendTime = 0;   // BUSY 가 알려준 등록 요청 재전송 시각 (ms)
+
+#define CONNECT_RETRY_MAX 3               // 부스 연결 재시도 최대 횟수
+#define CONNECT_TIMEOUT_MS 3000           // 부스 연결 응답 타임아웃 (3초)
+#define REGISTER_RETRY_MAX 3              // 등록 재시도 최대 횟수
+#define REGISTER_TIMEOUT_MS 3000          // 등록 응답 타임아웃 (3초)
+#define RESERVATION_GRACE_MS 3000         // 예약 시각 이후 입장 응답을 기다리는 여유 시간
+
+// RSSI 기반 부스 스캔
+static BoothScanInfo_t scannedBooths[MAX_BOOTHS]; // 스캔된 부스 정보 리스트
+static uint8_t isScanning = 0;                    // 스캔 중 여부 플래그
+static uint8_t scanResponseCount = 0;              // 스캔에 응답한 부스 수 (중복 제외)
+static uint8_t scanRetryCount = 0;                 // 응답이 없어 바로 다시 보낸 횟수
+static uint8_t rescanCount = 0;                    // 부스를 고르지 못하고 이어진 주기 스캔 수 (재스캔 백오프 지수)
+static uint8_t isRescanScheduled = 0;              // 다음 주기 스캔 시각이 정해짐
+static uint32_t rescanTime = 0;                    // 다음 주기 스캔 시각 (ms)
+static uint32_t scanStartTime = 0;                 // 현재 스캔 시작 시각 (이후에 들은 부스만 응답으로 셈)
+static uint8_t preferredBoothId = 0;               // 직전에 고른 부스 (히스테리시스 기준)
+
+// 스캔 응답 창: 관리자들은 슬롯 중 하나를 골라 응답, 마지막 슬롯 뒤 여유 시간까지 대기
+#define SCAN_WINDOW_MS (L3_SCAN_NBSLOTS * L3_SCAN_SLOTMS + L3_SCAN_GUARDMS)
+#define SCAN_EXPECTED_BOOTHS (ADMIN_ID_END - ADMIN_ID_START + 1) // 모두 응답하면 바로 선택
+
+// 부스 설명 캐시: 같은 버전이면 연결 시 설명 없는 BOOTH_INFO_SHORT 를 받음
+static BoothInfoCache_t infoCache[MAX_BOOTHS];
+
+// 채팅 기능 관련 변수 추가
+static uint8_t isTypingChat = 0;          // 채팅 입력 중 여부
+static char chatBuffer[101];              // 채팅 메시지 버퍼 (최대 100자)
+static uint8_t chatIndex = 0;             // 채팅 버퍼 인덱스
+static uint8_t isChatReady = 0;           // 입력을 마친 채팅 메시지가 있음 (메인 루프에서 전송)
+
+// 키보드 명령: ISR 은 명령만 기록하고 상태 전이/전송은 메인 루프에서 실행
+#define KEYCMD_NONE     0
+#define KEYCMD_ACCEPT   1                 // 'y' : 부스 체험 (USER_RESPONSE YES + REGISTER_REQUEST)
+#define KEYCMD_DECLINE  2                 // 'n' : 부스 체험 거부
+#define KEYCMD_EXIT     3                 // 'e' : 부스에서 나가기 또는 대기열 탈퇴
+static uint8_t keyCommand = KEYCMD_NONE;
+
+// 메시지 버퍼
+static uint8_t txBuffer[L3_MAXDATASIZE];
+
+// 시리얼 포트 인터페이스
+static Serial pc(USBTX, USBRX);
+
+// 함수 프로토타입 (코드 본문에서 자세히 설명)
+static uint8_t sendMessage(uint8_t msgType, uint8_t *data, uint8_t dataLen, uint8_t destId);
+static void sendConnectRequest(void);
+static void connectToBooth(uint8_t boothId);
+static void moveToOfferedBooth(void);
+static VirtualTicket_t *findTicket(uint8_t boothId);
+static void requestTickets(void);
+static void sendTicketRequest(VirtualTicket_t *ticket);
+static void withdrawTickets(uint8_t keepBoothId);
+static uint8_t promoteTicket(void);
+static void switchToTicketBooth(uint8_t boothId);
+static void retryConnectRequest(const char *reason);
+static void sendRegisterRequest(uint8_t isRetry);
+static void sendCallRegisterRequest(void);
+static uint8_t newReqId(void);
+static void retryRegisterRequest(const char *reason);
+static uint8_t canFastJoin(uint8_t boothId);
+static void handleBoothInfo(uint8_t currentUsers, uint8_t capacity, uint8_t waitingUsers, const char *description);
+static BoothInfoCache_t *findCachedInfo(uint8_t boothId);
+static void storeCachedInfo(uint8_t boothId, uint8_t infoVersion, const char *description);
+static void handleRegisterResponse(uint8_t *data);
+static void handleQueueInfo(uint8_t *data);
+static void printWaitingStatus();
+static void L3service_processKeyboardInput(void);
+static void runKeyCommand(uint8_t command);
+static void sendChatInput(void);
+
+// RSSI 기반 선택 함수 프로토타입
+static void initializeBoothScanList(void);
+static void startBoothScan(void);
+static void resumeScanning(void);
+static void resendBoothScan(void);
+static void markBoothVisited(uint8_t boothId);
+static uint8_t isBoothSelectable(const BoothScanInfo_t *booth, uint32_t maxAgeMs);
+static int16_t addBoothRssiSample(uint8_t boothId, int16_t rssi);
+static uint8_t updateBoothScanInfo(uint8_t boothId, int16_t rssi, uint8_t currentCount,
+                                   uint8_t capacity, uint8_t waitingCount, uint16_t etaSec);
+static uint8_t selectOptimalBooth(void);
+static void displayScannedBooths(void);
+
+// 수신 메시지 핸들러 (L3_msgHandler 레지스트리에 등록)
+static void L3service_onChatMessage(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onTimeoutAlert(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onAdminMessage(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onQueueReady(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onQueueUpdate(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onQueueSnapshot(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onExitResponse(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onBoothAnnounce(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onBoothInfo(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onBoothInfoShort(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onRegisterResponse(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onQueueInfo(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onJoinResponse(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onGroupData(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onRedirectOffer(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onTicketResponse(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+static void L3service_onBusy(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi);
+
+// 사용자 초기화: 부스 탐색 시작
+void L3service_init(uint8_t id)
+{
+    myId = id;
+
+    // 부스 스캔 목록 초기화 (RSSI 스캔 데이터 모두 초기화)
+    initializeBoothScanList();
+    L3_boothScore_init();
+
+    pc.printf("\n=== USER MODE: ID %d ===\n", id);
+    pc.printf("Starting RSSI-based booth scanning...\n");
+    pc.printf("Press 'e' to exit booth when inside\n");
+    pc.printf("Press 'c' to chat when inside booth\n");  // 채팅 안내 추가
+    pc.printf("Press 'j' to toggle fast join (enter without the booth info prompt)\n");
+    pc.printf("Press 'x' to move to another booth when one is offered while waiting\n");
+    pc.printf("Press 'v' to toggle virtual tickets (wait in several booth queues at once)\n");
+    pc.printf("Session limit: %d seconds per booth\n", SESSION_DURATION_MS / 1000);
+    main_state = L3STATE_SCANNING; // 초기 상태: SCANNING
+
+    // 키보드 인터럽트 설정: 사용자가 'e'를 눌러 부스에서 나갈 수 있도록
+    pc.attach(&L3service_processKeyboardInput, Serial::RxIrq);
+
+    // 초기 스캔 시작: 부스 탐색 요청 전송
+    pc.printf("Initiating booth discovery...\n");
+    scanRetryCount = 0;
+    startBoothScan();
+}
+
+// 사용자 메시지 핸들러 등록: (역할, 상태, 메시지 타입) -> 핸들러
+// 새 메시지 타입은 여기에 한 줄 추가하고 핸들러 함수를 작성하면 됨
+void L3service_registerHandlers(void)
+{
+    L3_handler_register(L3ROLE_USER, L3STATE_IN_USE,       MSG_TYPE_CHAT_MESSAGE,     L3service_onChatMessage);
+    L3_handler_register(L3ROLE_USER, L3STATE_IN_USE,       MSG_TYPE_CHAT_COMPACT,     L3service_onChatMessage);
+    L3_handler_register(L3ROLE_USER, L3_HANDLER_STATE_ANY, MSG_TYPE_TIMEOUT_ALERT,    L3service_onTimeoutAlert);
+    L3_handler_register(L3ROLE_USER, L3_HANDLER_STATE_ANY, MSG_TYPE_ADMIN_MESSAGE,    L3service_onAdminMessage);
+    L3_handler_register(L3ROLE_USER, L3STATE_WAITING,      MSG_TYPE_QUEUE_READY,      L3service_onQueueReady);
+    L3_handler_register(L3ROLE_USER, L3STATE_WAITING,      MSG_TYPE_QUEUE_UPDATE,     L3service_onQueueUpdate);
+    L3_handler_register(L3ROLE_USER, L3STATE_WAITING,      MSG_TYPE_QUEUE_SNAPSHOT,   L3service_onQueueSnapshot);
+    L3_handler_register(L3ROLE_USER, L3_HANDLER_STATE_ANY, MSG_TYPE_EXIT_RESPONSE,    L3service_onExitResponse);
+    L3_handler_register(L3ROLE_USER, L3_HANDLER_STATE_ANY, MSG_TYPE_BOOTH_ANNOUNCE,   L3service_onBoothAnnounce);
+    L3_handler_register(L3ROLE_USER, L3STATE_CONNECTED,    MSG_TYPE_BOOTH_INFO,       L3service_onBoothInfo);
+    L3_handler_register(L3ROLE_USER, L3STATE_CONNECTED,    MSG_TYPE_BOOTH_INFO_SHORT, L3service_onBoothInfoShort);
+    L3_handler_register(L3ROLE_USER, L3_HANDLER_STATE_ANY, MSG_TYPE_REGISTER_RESPONSE, L3service_onRegisterResponse);
+    L3_handler_register(L3ROLE_USER, L3_HANDLER_STATE_ANY, MSG_TYPE_QUEUE_INFO,       L3service_onQueueInfo);
+    L3_handler_register(L3ROLE_USER, L3_HANDLER_STATE_ANY, MSG_TYPE_JOIN_RESPONSE,    L3service_onTicketResponse);
+    L3_handler_register(L3ROLE_USER, L3STATE_CONNECTED,    MSG_TYPE_JOIN_RESPONSE,    L3service_onJoinResponse);
+    L3_handler_register(L3ROLE_USER, L3STATE_IN_USE,       MSG_TYPE_GROUP_DATA,       L3service_onGroupData);
+    L3_handler_register(L3ROLE_USER, L3STATE_WAITING,      MSG_TYPE_REDIRECT_OFFER,   L3service_onRedirectOffer);
+    L3_handler_register(L3ROLE_USER, L3_HANDLER_STATE_ANY, MSG_TYPE_BUSY,             L3service_onBusy);
+}
+
+uint8_t L3service_getState(void)
+{
+    return main_state;
+}
+
+// 사용자 주기 처리: 부스 선택 타임아웃 및 상태별 타이머
+void L3service_run(void)
+{
+    if (prev_state != main_state)
+    {
+        // 상태 전이 로그 (디버그용)
+        debug_if(DBGMSG_L3, "[L3] State transition from %i to %i\n", prev_state, main_state);
+        prev_state = main_state;
+    }
+
+    // 부스 선택 타임아웃 처리 (사용자 측)
+    if (L3_event_checkEventFlag(L3_event_boothSelectionTimeout))
+    {
+        if (isScanning && scanResponseCount == 0 && scanRetryCount < L3_SCAN_RETRY_MAX)
+        {
+            // 방송 스캔은 ARQ 가 없으므로 아무 응답이 없으면 바로 한 번 더 보냄
+            //   - 같이 스캔한 사용자들과 다시 겹치지 않도록 지터 백오프 뒤에 보냄
+            uint32_t delayMs = L2_backoff_jitterMs(L3_RETRY_BASEMS, L3_RETRY_CAPMS, scanRetryCount);
+            scanRetryCount++;
+            pc.printf("\n[User] No booth answered, re-sending scan in %d ms (%d/%d)...\n", delayMs, scanRetryCount, L3_SCAN_RETRY_MAX);
+            if (!L3_deferred_call(resendBoothScan, delayMs))
+            {
+                startBoothScan();
+            }
+        }
+        else if (isScanning)
+        {
+            isScanning = 0;
+            scanRetryCount = 0;
+            pc.printf("\n[User] Booth scan finished (%d booth(s) answered). Processing RSSI data...\n", scanResponseCount);
+
+            // 스캔된 모든 부스 정보 출력 (디버그)
+            displayScannedBooths();
+
+            // RSSI를 기반으로 최적 부스 선택
+            uint8_t selectedBoothId = selectOptimalBooth();
+
+            if (selectedBoothId != 0)
+            {
+                pc.printf("\nSelected Booth %d as optimal choice\n", selectedBoothId);
+                connectToBooth(selectedBoothId);
+            }
+            else
+            {
+                // 목록은 유지 (오래된 항목은 나이로 제외됨), 주기 스캔 계속
+                pc.printf("\nNo unvisited booths found. Continuing scan...\n");
+            }
+        }
+        L3_event_clearEventFlag(L3_event_boothSelectionTimeout); // 플래그 클리어
+    }
+
+    // 다른 부스 안내를 받아들임 (키보드 ISR 에서 표시, 전송은 여기서)
+    if (isOfferAccepted)
+    {
+        isOfferAccepted = 0;
+        if (main_state == L3STATE_WAITING && offerBoothId != 0)
+        {
+            moveToOfferedBooth();
+        }
+    }
+
+    // 키보드 명령과 채팅 입력 (ISR 에서 기록, 전송은 여기서)
+    if (keyCommand != KEYCMD_NONE)
+    {
+        uint8_t command = keyCommand;
+        keyCommand = KEYCMD_NONE;
+        runKeyCommand(command);
+    }
+    if (isChatReady)
+    {
+        sendChatInput();
+    }
+
+    // 대기열을 떠났거나 모드를 끄면 남은 대기표 반납 (입장/이동한 부스의 대기표는 유지할 필요 없음)
+    if (nbTickets > 0 && (!isTicketMode || main_state != L3STATE_WAITING))
+    {
+        withdrawTickets(currentBoothId);
+    }
+
+    // 부스 안/대기 중에는 주기적으로 생존 알림 (관리자가 사라진 사용자의 자리/순번을 정리하는 기준)
+    if ((main_state == L3STATE_IN_USE || main_state == L3STATE_WAITING) &&
+        L3_timer_getMs() - lastKeepaliveTime >= L3_KEEPALIVE_PERIODMS)
+    {
+        lastKeepaliveTime = L3_timer_getMs();
+
+        uint8_t keepaliveMsg[2];
+        uint8_t msgSize = L3_msg_encodeKeepalive(keepaliveMsg, main_state);
+        L3_LLI_dataReqFunc(keepaliveMsg, msgSize, currentBoothId);
+
+        // 가상 대기표: 다른 부스 대기열에도 생존 알림, 빈 대기표는 새 부스에 요청
+        for (uint8_t i = 0; i < L3_TICKET_MAX; i++)
+        {
+            if (tickets[i].boothId != 0 && tickets[i].position != 0)
+            {
+                L3_LLI_dataReqFunc(keepaliveMsg, msgSize, tickets[i].boothId);
+            }
+        }
+        requestTickets();
+    }
+
+    // 사용자 상태 머신
+    static uint32_t sessionDisplayTimer = 0;
+
+    switch (main_state)
+    {
+    case L3STATE_SCANNING:
+        // 주기적 스캔: 스캔이 끝났는데 부스를 고르지 못했으면 지터 백오프 뒤 재스캔 (빈 주기마다 창이 두 배)
+        if (!isScanning && !isRescanScheduled)
+        {
+            isRescanScheduled = 1;
+            rescanTime = L3_timer_getMs() + L2_backoff_jitterMs(L3_RESCAN_BASEMS, L3_RESCAN_CAPMS, rescanCount);
+        }
+        else if (!isScanning && (int32_t)(L3_timer_getMs() - rescanTime) >= 0)
+        {
+            if (rescanCount < 0xFF)
+            {
+                rescanCount++;
+            }
+            pc.printf("\n[User] Starting new RSSI-based scan cycle...\n");
+
+            // RSSI 스캔 재시작 (목록은 지우지 않고 응답으로 갱신)
+            scanRetryCount = 0;
+            startBoothScan();
+        }
+        break;
+
+    case L3STATE_CONNECTED:
+        // BOOTH_INFO (또는 JOIN_RESPONSE) 응답을 기다리는 중 타임아웃 처리
+        // (전송 실패는 DATA_CNF 로 바로 재시도, 타임아웃은 응답 유실 대비)
+        //   - BUSY 를 받았으면 타임아웃 대신 관리자가 알려준 시각에 같은 요청 ID 로 재전송 (재시도 횟수에 넣지 않음)
+        if (isWaitingForBoothInfo && isConnectDeferred)
+        {
+            if ((int32_t)(L3_timer_getMs() - connectResendTime) >= 0)
+            {
+                pc.printf("\n[User] Re-sending connect request to Booth %d\n", currentBoothId);
+                sendConnectRequest();
+            }
+        }
+        else if (isWaitingForBoothInfo && (int32_t)(L3_timer_getMs() - connectRetryTime) >= 0)
+        {
+            retryConnectRequest("No response from booth");
+        }
+
+        // REGISTER_RESPONSE 응답을 기다리는 중 타임아웃 처리
+        if (isWaitingForRegisterResponse && isRegisterDeferred)
+        {
+            if ((int32_t)(L3_timer_getMs() - registerResendTime) >= 0)
+            {
+                pc.printf("\n[User] Re-sending registration request to Booth %d\n", currentBoothId);
+                sendRegisterRequest(1);
+            }
+        }
+        else if (isWaitingForRegisterResponse && (int32_t)(L3_timer_getMs() - registerRetryTime) >= 0)
+        {
+            retryRegisterRequest("No registration response");
+        }
+        break;
+
+    case L3STATE_WAITING:
+        // 대기열 상태 표시
+        static uint32_t waitingDotTimer = 0;
+        static uint32_t waitingAnimTimer = 0;
+        static uint8_t animIndex = 0;
+
+        // 예약 후 입장 응답이 유실된 경우: 직접 등록 요청 (관리자는 이미 입장한 사용자에게 성공을 다시 보냄)
+        if (isReserved && (int32_t)(L3_timer_getMs() - reservationDeadline) >= 0)
+        {
+            isReserved = 0;
+            pc.printf("\n[User] No admission after reservation, sending registration request...\n");
+            sendCallRegisterRequest();
+        }
+
+        // BUSY 로 미룬 등록 요청/대기표 요청: 관리자가 알려준 시각에 같은 요청 ID 로 재전송
+        if (isCallRegistering && isRegisterDeferred && (int32_t)(L3_timer_getMs() - registerResendTime) >= 0)
+        {
+            pc.printf("\n[User] Re-sending registration request to Booth %d\n", currentBoothId);
+            sendCallRegisterRequest();
+        }
+        for (uint8_t i = 0; i < L3_TICKET_MAX; i++)
+        {
+            if (tickets[i].boothId != 0 && tickets[i].position == 0 && tickets[i].isDeferred &&
+                (int32_t)(L3_timer_getMs() - tickets[i].resendTime) >= 0)
+            {
+                sendTicketRequest(&tickets[i]);
+            }
+        }
+
+        waitingAnimTimer++;
+        if (waitingAnimTimer > 5000000)
+        {
+            waitingAnimTimer = 0;
+            pc.printf("\r Waiting... Position: %d/%d   ",
+                      myWaitingNumber, totalWaitingUsers);
+        }
+        break;
+
+    case L3STATE_IN_USE:
+        // 부스 사용 중 남은 시간 주기적 표시
+        sessionDisplayTimer++;
+        if (sessionDisplayTimer > 60000000 && isSessionActive)
+        { // 60초마다 남은 시간 표시
+            sessionDisplayTimer = 0;
+            uint32_t currentTime = us_ticker_read() / 1000;
+            uint32_t elapsedTime = currentTime - sessionStartTime;
+            
+            // ** 남은 시간 계산 시 언더플로우 방지를 위해 elapsedTime < SESSION_DURATION_MS 체크 필요
+            if (elapsedTime < SESSION_DURATION_MS)
+            {
+                uint32_t remainingTime = (SESSION_DURATION_MS - elapsedTime) / 1000;
+                pc.printf("\n[Info] Time remaining: %d seconds\n", remainingTime);
+                pc.printf("Press 'c' to chat, 'e' to exit\n");  // 채팅 안내 추가
+            }
+            else
+            {
+                // 세션 만료됨(서버 측 타임아웃 알림 대기 중)
+                pc.printf("\n[Info] Session expired. Waiting for server timeout...\n");
+                isSessionActive = 0; // 더 이상 남은 시간 표시 안 함
+            }
+        }
+        // 사용자 측 세션 타이머 체크 (백업 메커니즘) - 기존 시간 계산 재사용
+        if (isSessionActive == 0) // 세션이 만료된 상태라면
+        {
+            uint32_t currentTime = us_ticker_read() / 1000;
+            uint32_t elapsedTime = currentTime - sessionStartTime;
+
+            // 세션 시간 + 5초 여유시간 후 강제 전환
+            if (elapsedTime > (SESSION_DURATION_MS + 5000))
+            {
+                pc.printf("\n[Warning] Session timeout detected on client side!\n");
+                pc.printf("Automatically returning to scanning mode...\n");
+
+                // 서버 퇴장 요청 전송 (선택 사항)
+                sendMessage(MSG_TYPE_EXIT_REQUEST, NULL, 0, currentBoothId);
+
+                // 강제로 SCANNING 상태로 전환
+                markBoothVisited(currentBoothId);
+                main_state = L3STATE_SCANNING;
+                currentBoothId = 0;
+                isSessionActive = 0;
+                sessionStartTime = 0;
+
+                // 최근에 들은 다음 부스로 바로 이동 (없으면 스캔)
+                resumeScanning();
+
+                pc.printf("Returned to scanning mode due to session timeout.\n");
+                //pc.printf("[DEBUG] State transition: IN_USE -> SCANNING (client timeout)\n");
+            }
+        }
+        break;
+    }
+}
+
+// 채팅 메시지 수신 (사용자 측, IN_USE)
+static void L3service_onChatMessage(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    // 사용자가 부스 내에서 채팅 메시지 수신
+    uint8_t *msgData = L3_msg_getData(msg);
+    uint8_t originalSenderId;
+    char *chatMsg;
+    char text[L3_CHAT_MAXLEN + 1];
+
+    // 메시지 포맷 확인 (압축 형식은 플래그로, 구 형식은 첫 바이트가 유효한 사용자 ID인지로)
+    if (L3_msg_getType(msg) == MSG_TYPE_CHAT_COMPACT) {
+        if (!L3_msg_getChatCompact(msg, size, &originalSenderId, text, sizeof(text))) {
+            return;
+        }
+        if (originalSenderId == 0) {
+            originalSenderId = srcId;
+        }
+        chatMsg = text;
+    } else if (msgData[0] >= 4 && msgData[0] <= 254) {
+        // Admin이 중계한 메시지 (발신자 ID 포함)
+        originalSenderId = msgData[0];
+        chatMsg = (char*)(msgData + 1);
+    } else {
+        // 직접 수신한 메시지 (구 형식)
+        originalSenderId = srcId;
+        chatMsg = (char*)msgData;
+    }
+
+    // 채팅 입력 중이면 줄바꿈 후 메시지 표시
+    if (isTypingChat)
+    {
+        pc.printf("\n");
+    }
+
+    // 자신이 보낸 메시지는 이미 표시했으므로 스킵
+    if (originalSenderId != myId)
+    {
+        pc.printf("[CHAT] User %d: %s\n", originalSenderId, chatMsg);
+    }
+
+    // 채팅 입력 중이었다면 프롬프트 다시 표시
+    if (isTypingChat)
+    {
+        pc.printf("Continue typing: ");
+        // 현재까지 입력한 내용 다시 표시
+        for (uint8_t i = 0; i < chatIndex; i++)
+        {
+            pc.putc(chatBuffer[i]);
+        }
+    }
+}
+
+// 타이머 만료 알림 처리 (사용자 측)
+static void L3service_onTimeoutAlert(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    // 지금 있는 부스의 알림만 처리 (이전 부스의 늦은 알림 무시)
+    if (srcId != currentBoothId)
+    {
+        return;
+    }
+
+    pc.printf("\n[ALERT] Your session time has expired!\n");
+    pc.printf("You are being automatically exited from the booth.\n");
+    pc.printf("Thank you for your experience!\n");
+
+    // 세션 만료 시 스캔 상태로 복귀 (타임아웃 알림 받으면 자동으로 나감)
+    markBoothVisited(currentBoothId);
+    main_state = L3STATE_SCANNING;
+    currentBoothId = 0;
+    isSessionActive = 0;
+    sessionStartTime = 0;
+
+    pc.printf("\nReturning to booth scanning mode...\n");
+    resumeScanning();
+}
+
+// 관리자 방송 메시지 수신 (사용자 측)
+static void L3service_onAdminMessage(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    char *adminMsg = (char *)L3_msg_getData(msg);
+    pc.printf("\n[ADMIN BROADCAST] %s\n", adminMsg);
+}
+
+// 부스 그룹 멀티캐스트 수신 (사용자 측, IN_USE)
+static void L3service_onGroupData(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    // 다른 부스의 그룹 방송은 무시
+    if (srcId != currentBoothId)
+    {
+        return;
+    }
+
+    uint8_t innerLen;
+    uint8_t *inner = L3_group_receive(srcId, msg, size, &innerLen);
+    if (inner == NULL || L3_msg_getType(inner) == MSG_TYPE_GROUP_DATA)
+    {
+        return;
+    }
+
+    // 내부 메시지 (채팅, 관리자 메시지)는 일반 메시지와 같은 핸들러로 처리
+    L3_handler_dispatch(main_state, srcId, inner, innerLen, rssi);
+}
+
+// 대기 사용자에게 입장 알림 (사용자 측, WAITING)
+static void L3service_onQueueReady(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    // 가상 대기표: 먼저 부른 부스로 가고 나머지 대기열은 모두 떠남
+    uint8_t isTicketWin = 0;
+    if (srcId != currentBoothId)
+    {
+        if (findTicket(srcId) == NULL)
+        {
+            return;
+        }
+        switchToTicketBooth(srcId);
+        isTicketWin = 1;
+    }
+    else if (nbTickets > 0)
+    {
+        withdrawTickets(currentBoothId);
+    }
+
+    uint8_t leadSec = 0;
+    if (size > L3_MSG_OFFSET_DATA + L3_QUEUEREADY_OFFSET_LEAD)
+    {
+        leadSec = L3_msg_getData(msg)[L3_QUEUEREADY_OFFSET_LEAD];
+    }
+
+    if (leadSec > 0)
+    {
+        // 예약 호출: 자리가 곧 빔, 미리 등록해 두면 자리가 비는 즉시 관리자가 입장 처리
+        pc.printf("\n[Alert] Get ready! The booth frees up in about %d seconds.\n", leadSec);
+        pc.printf("You will be admitted automatically. Please stay near the booth.\n");
+        sendMessage(MSG_TYPE_QUEUE_READY_ACK, NULL, 0, currentBoothId);
+
+        isReserved = 1;
+        reservationDeadline = L3_timer_getMs() + (uint32_t)leadSec * 1000 + RESERVATION_GRACE_MS;
+        return;
+    }
+
+    // 근접 확인: 부스 신호의 평균 RSSI 가 기준 이상이면 자동으로 입장 확인
+    //   - 멀리 있으면 한 번 알리고, 관리자가 다시 호출할 때마다 새 RSSI 로 다시 판단
+    //   - 다른 부스 대기표로 불린 경우는 지금 다른 부스 앞에 있으므로 근접 확인 없이 바로 입장 확인
+    int16_t avgRssi = addBoothRssiSample(srcId, rssi);
+    if (avgRssi < L3_PRESENCE_RSSI && !isTicketWin)
+    {
+        if (!isFarNotified)
+        {
+            pc.printf("\n[Alert] Your turn has arrived! Please come closer to the booth (signal %d dBm).\n", avgRssi);
+            pc.printf("You will be admitted automatically once you are near.\n");
+
+            uint8_t rssiData[1];
+            rssiData[0] = (uint8_t)(int8_t)avgRssi;
+            sendMessage(MSG_TYPE_QUEUE_READY_ACK, rssiData, 1, currentBoothId);
+            isFarNotified = 1;
+        }
+        return;
+    }
+
+    pc.printf("\n[Alert] Your turn has arrived!\n");
+    pc.printf("Presence confirmed (signal %d dBm). Entering booth...\n", avgRssi);
+    isFarNotified = 0;
+
+    // 자동으로 REGISTER_REQUEST 전송 (근접 확인 = 입장 의사 표시)
+    sendCallRegisterRequest();
+}
+
+// 대기열 위치/총 대기 사용자 수 업데이트 (사용자 측, WAITING)
+static void L3service_onQueueUpdate(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    uint8_t *msgData = L3_msg_getData(msg);
+
+    // 다른 부스 대기표의 순번 변경/제거
+    if (srcId != currentBoothId)
+    {
+        VirtualTicket_t *ticket = findTicket(srcId);
+        if (ticket == NULL)
+        {
+            return;
+        }
+        if (msgData[0] == 0 || msgData[1] == 0)
+        {
+            pc.printf("\n[Ticket] Removed from the queue of Booth %d\n", srcId);
+            ticket->boothId = 0;
+            nbTickets--;
+        }
+        else
+        {
+            ticket->position = msgData[0];
+            ticket->totalWaiting = msgData[1];
+        }
+        return;
+    }
+
+    myWaitingNumber = msgData[0];
+    totalWaitingUsers = msgData[1];
+
+    // 대기열에서 제거된 경우: 순번 0 또는 총 대기 인원 0
+    if (myWaitingNumber == 0 || totalWaitingUsers == 0)
+    {
+        isReserved = 0;
+        isFarNotified = 0;
+        isCallRegistering = 0;
+        offerBoothId = 0;
+
+        // 다른 부스 대기표가 있으면 그 부스 대기를 이어감
+        if (promoteTicket())
+        {
+            return;
+        }
+
+        pc.printf("\n[Notice] You have been removed from the waiting queue.\n");
+        pc.printf("Returning to scanning mode...\n");
+        main_state = L3STATE_SCANNING;
+        currentBoothId = 0;
+        resumeScanning();
+    }
+    else
+    {
+        pc.printf("\n[Queue Update] Your position: %d/%d\n", myWaitingNumber, totalWaitingUsers);
+    }
+}
+
+// 다른 부스 안내 수신 (사용자 측, WAITING)
+//   - 빠른 입장(사전 동의)이면 바로 이동, 아니면 'x' 로 수락
+static void L3service_onRedirectOffer(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    if (srcId != currentBoothId || size < L3_MSG_OFFSET_DATA + L3_REDIRECT_OFFSET_ETA + 2)
+    {
+        return;
+    }
+
+    offerBoothId = L3_msg_getData(msg)[L3_REDIRECT_OFFSET_BOOTH];
+    uint16_t etaSec = L3_msg_getEta(msg, size, L3_REDIRECT_OFFSET_ETA);
+
+    pc.printf("\n[Offer] Booth %d can take you in about %d sec (your position here: %d/%d)\n",
+              offerBoothId, etaSec, myWaitingNumber, totalWaitingUsers);
+    if (autoJoin)
+    {
+        isOfferAccepted = 1;
+    }
+    else
+    {
+        pc.printf("Press 'x' to move to Booth %d\n", offerBoothId);
+    }
+}
+
+// 다른 부스 대기표 요청 응답 (사용자 측, 모든 상태 / CONNECTED 는 L3service_onJoinResponse 를 거침)
+//   - 바로 입장 가능하면 그 부스로 이동, 만원이면 대기표 순번 기록
+//   - 대기표를 반납한 뒤 (다른 상태 포함) 늦게 온 입장 성공은 EXIT_REQUEST 로 자리를 돌려줌
+static void L3service_onTicketResponse(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    if (srcId == currentBoothId || size < L3_MSG_OFFSET_DATA + L3_JOIN_OFFSET_TOTAL + 1)
+    {
+        return;
+    }
+
+    uint8_t *msgData = L3_msg_getData(msg);
+    uint8_t reason = msgData[L3_JOIN_OFFSET_REASON];
+    VirtualTicket_t *ticket = findTicket(srcId);
+
+    if (ticket == NULL || main_state != L3STATE_WAITING)
+    {
+        // 대기표를 반납한 뒤 늦게 입장 처리됨: 자리를 바로 돌려줌
+        if (reason == REGISTER_REASON_SUCCESS)
+        {
+            pc.printf("[Ticket] Late admission from Booth %d, releasing the slot\n", srcId);
+            sendMessage(MSG_TYPE_EXIT_REQUEST, NULL, 0, srcId);
+        }
+        return;
+    }
+
+    if (reason == REGISTER_REASON_SUCCESS)
+    {
+        pc.printf("\n[Ticket] Booth %d has room now, moving there\n", srcId);
+        switchToTicketBooth(srcId);
+
+        uint8_t registerData[2];
+        registerData[0] = 1;
+        registerData[1] = reason;
+        handleRegisterResponse(registerData);
+    }
+    else if (reason == REGISTER_REASON_FULL_WAITING)
+    {
+        ticket->position = msgData[L3_JOIN_OFFSET_POSITION];
+        ticket->totalWaiting = msgData[L3_JOIN_OFFSET_TOTAL];
+        ticket->etaSec = L3_msg_getEta(msg, size, L3_JOIN_OFFSET_ETA);
+        pc.printf("\n[Ticket] Also waiting at Booth %d: position %d/%d\n", srcId, ticket->position, ticket->totalWaiting);
+    }
+    else
+    {
+        // 이미 체험했거나 대기열이 가득 참: 대기표 삭제 (체험한 부스는 다시 요청하지 않음)
+        if (reason == REGISTER_REASON_ALREADY_USED)
+        {
+            markBoothVisited(srcId);
+        }
+        ticket->boothId = 0;
+        nbTickets--;
+    }
+}
+
+// 대기열 스냅샷 방송 수신 (사용자 측, WAITING): 내 ID 를 찾아 순번 계산
+static void L3service_onQueueSnapshot(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    if (srcId != currentBoothId || !L3_msg_checkQueueSnapshot(msg, size))
+    {
+        return;
+    }
+
+    uint8_t *msgData = L3_msg_getData(msg);
+    uint8_t version = msgData[L3_SNAPSHOT_OFFSET_VERSION];
+
+    // 이전 버전 스냅샷 무시 (버전 wrap 대비 부호 있는 차이로 비교)
+    if (hasSnapshotVersion && (int8_t)(version - lastSnapshotVersion) < 0)
+    {
+        return;
+    }
+
+    uint8_t count = msgData[L3_SNAPSHOT_OFFSET_COUNT];
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (L3_msg_getQueueSnapshotId(msg, i) == myId)
+        {
+            uint8_t position = msgData[L3_SNAPSHOT_OFFSET_FIRSTPOS] + i;
+            uint8_t total = msgData[L3_SNAPSHOT_OFFSET_TOTAL];
+
+            lastSnapshotVersion = version;
+            hasSnapshotVersion = 1;
+
+            if (position != myWaitingNumber || total != totalWaitingUsers)
+            {
+                myWaitingNumber = position;
+                totalWaitingUsers = total;
+                pc.printf("\n[Queue Update] Your position: %d/%d\n", myWaitingNumber, totalWaitingUsers);
+            }
+            return;
+        }
+    }
+}
+
+// 부스 퇴장 확인 응답 (사용자 측)
+static void L3service_onExitResponse(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    uint8_t *msgData = L3_msg_getData(msg);
+    uint8_t success = msgData[0];
+
+    if (success)
+    {
+        pc.printf("[User] EXIT_RESPONSE received - exiting complete.\n");
+
+        // 부스 정보 초기화 및 상태 전이
+        markBoothVisited(currentBoothId);
+        main_state = L3STATE_SCANNING;
+        currentBoothId = 0;
+        resumeScanning();
+    }
+    else
+    {
+        pc.printf("[User] EXIT_RESPONSE failed - cannot exit.\n");
+    }
+}
+
+// 부스 방송 메시지 수신 (사용자 측, 모든 상태)
+//   - 스캔 중이 아니어도 들리는 방송으로 부스 목록을 계속 갱신
+static void L3service_onBoothAnnounce(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    uint8_t *msgData = L3_msg_getData(msg);
+    uint8_t boothId = msgData[0];
+    uint8_t currentUsers = msgData[1];
+    uint8_t capacity = msgData[2];
+    uint8_t waitingUsers = msgData[3];
+    uint16_t etaSec = L3_msg_getEta(msg, size, L3_ANNOUNCE_OFFSET_ETA);
+    uint8_t infoVersion = L3_msg_getInfoVersion(msg, size, L3_ANNOUNCE_OFFSET_INFOVER);
+
+    // 부스 설명이 바뀌었으면 캐시 폐기 (다음 연결에서 전체 BOOTH_INFO 수신)
+    BoothInfoCache_t *cached = findCachedInfo(boothId);
+    if (cached != NULL && infoVersion != L3_INFOVER_NONE && cached->infoVersion != infoVersion)
+    {
+        cached->infoVersion = L3_INFOVER_NONE;
+    }
+
+    // 스캔 목록에 RSSI 정보 업데이트
+    uint8_t isNew = updateBoothScanInfo(boothId, rssi, currentUsers, capacity, waitingUsers, etaSec);
+
+    if (!isScanning)
+    {
+        return;
+    }
+
+    pc.printf("\nBooth %d detected! RSSI: %d dBm (Users: %d/%d, Waiting: %d)\n",
+              boothId, rssi, currentUsers, capacity, waitingUsers);
+
+    if (isNew)
+    {
+        scanResponseCount++;
+    }
+
+    // 모든 부스가 응답했으면 남은 응답 창을 기다리지 않고 바로 선택
+    if (scanResponseCount >= SCAN_EXPECTED_BOOTHS)
+    {
+        L3_timer_boothSelectionStop();
+        L3_event_setEventFlag(L3_event_boothSelectionTimeout);
+    }
+}
+
+// 부스 정보 수신 (사용자 측, CONNECTED)
+static void L3service_onBoothInfo(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    pc.printf("\n[User] Received booth info from Booth %d\n", srcId);
+
+    // 연결 성공 처리: 정보 플래그 초기화 및 재시도 카운터 초기화
+    isWaitingForBoothInfo = 0;
+    connectRetryCount = 0;
+
+    // 설명을 부스 ID + 버전으로 캐시 (버전이 없는 구 형식이면 캐시하지 않음)
+    uint8_t *msgData = L3_msg_getData(msg);
+    const char *description = (const char *)(msgData + L3_BOOTHINFO_OFFSET_DESC);
+    uint8_t infoVersion = L3_msg_getBoothInfoVersion(msg, size);
+    if (infoVersion != L3_INFOVER_NONE)
+    {
+        storeCachedInfo(srcId, infoVersion, description);
+    }
+
+    handleBoothInfo(msgData[0], msgData[1], msgData[2], description);
+}
+
+// 설명 없는 부스 정보 수신 (사용자 측): 캐시된 설명과 현재 인원으로 안내
+static void L3service_onBoothInfoShort(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    if (srcId != currentBoothId || !isWaitingForBoothInfo ||
+        size < L3_MSG_OFFSET_DATA + L3_INFOSHORT_OFFSET_INFOVER + 1)
+    {
+        return;
+    }
+
+    uint8_t *msgData = L3_msg_getData(msg);
+    BoothInfoCache_t *cached = findCachedInfo(srcId);
+    if (cached == NULL || cached->infoVersion != msgData[L3_INFOSHORT_OFFSET_INFOVER])
+    {
+        // 응답 사이에 캐시가 바뀐 경우: 캐시 없이 다시 요청해 전체 정보 수신
+        if (cached != NULL)
+        {
+            cached->infoVersion = L3_INFOVER_NONE;
+        }
+        pc.printf("\n[User] Cached booth info is gone, requesting full info...\n");
+        connectReqId = newReqId(); // 다른 요청 (캐시 없음) 이므로 새 ID
+        sendConnectRequest();
+        return;
+    }
+
+    pc.printf("\n[User] Received booth info from Booth %d (cached description)\n", srcId);
+
+    isWaitingForBoothInfo = 0;
+    connectRetryCount = 0;
+
+    handleBoothInfo(msgData[L3_INFOSHORT_OFFSET_CURRENT], msgData[L3_INFOSHORT_OFFSET_CAPACITY],
+                    msgData[L3_INFOSHORT_OFFSET_WAITING], cached->description);
+}
+
+// 등록 응답 수신 (사용자 측)
+static void L3service_onRegisterResponse(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    pc.printf("\n[User] Received REGISTER_RESPONSE\n");
+
+    // 등록 응답 대기 플래그 해제
+    isWaitingForRegisterResponse = 0;
+    registerRetryCount = 0;
+
+    handleRegisterResponse(L3_msg_getData(msg));
+}
+
+// 빠른 입장 응답 수신 (사용자 측, CONNECTED)
+//   - REGISTER_RESPONSE 와 같은 사유 코드, 대기열 등록이면 순번/총 대기 인원/예상 시간도 함께 옴
+static void L3service_onJoinResponse(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    // 다른 부스의 응답은 반납한 대기표의 늦은 응답
+    if (srcId != currentBoothId)
+    {
+        L3service_onTicketResponse(srcId, msg, size, rssi);
+        return;
+    }
+
+    if (!isJoinRequest || !isWaitingForBoothInfo ||
+        size < L3_MSG_OFFSET_DATA + L3_JOIN_OFFSET_TOTAL + 1)
+    {
+        return;
+    }
+
+    pc.printf("\n[User] Received JOIN_RESPONSE\n");
+
+    // 연결 응답 대기 해제 (JOIN 은 연결 재시도 절차를 그대로 사용)
+    isWaitingForBoothInfo = 0;
+    isJoinRequest = 0;
+    connectRetryCount = 0;
+
+    uint8_t *msgData = L3_msg_getData(msg);
+    uint8_t reason = msgData[L3_JOIN_OFFSET_REASON];
+
+    // REGISTER_RESPONSE 형식 (성공 여부, 사유)으로 바꿔 같은 처리 경로 사용
+    uint8_t registerData[2];
+    registerData[0] = (reason == REGISTER_REASON_SUCCESS);
+    registerData[1] = reason;
+    handleRegisterResponse(registerData);
+
+    if (reason == REGISTER_REASON_FULL_WAITING)
+    {
+        // 별도 QUEUE_INFO 없이 바로 순번 표시
+        myEtaSec = L3_msg_getEta(msg, size, L3_JOIN_OFFSET_ETA);
+        lastQueuePosition = msgData[L3_JOIN_OFFSET_POSITION];
+        lastTotalWaiting = msgData[L3_JOIN_OFFSET_TOTAL];
+        myWaitingNumber = lastQueuePosition;
+        totalWaitingUsers = lastTotalWaiting;
+        printWaitingStatus();
+    }
+}
+
+// 요청 처리 보류 수신 (사용자 측)
+//   - 관리자가 요청 폭주로 지금 처리하지 않음: 응답 타임아웃 재시도 대신 retry-after 뒤에 같은 요청 ID 로 재전송
+//   - 연결/등록 요청 (CONNECTED), 입장 호출의 등록 요청 (WAITING), 다른 부스 대기표 요청 (WAITING) 이 대상
+//   - 보류된 등록/입장 요청은 그 전에 응답이 오면 재전송하지 않음
+static void L3service_onBusy(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    if (size < L3_MSG_OFFSET_DATA + L3_BUSY_OFFSET_RETRYMS + 2)
+    {
+        return;
+    }
+
+    uint8_t *msgData = L3_msg_getData(msg);
+    uint8_t reqType = msgData[L3_BUSY_OFFSET_REQTYPE];
+    uint8_t reqId = msgData[L3_BUSY_OFFSET_REQID];
+    uint16_t retryMs = ((uint16_t)msgData[L3_BUSY_OFFSET_RETRYMS] << 8) | msgData[L3_BUSY_OFFSET_RETRYMS + 1];
+
+    if (srcId != currentBoothId)
+    {
+        // 다른 부스 대기표: 응답 전인 대기표만 재전송을 미룸
+        VirtualTicket_t *ticket = findTicket(srcId);
+        if (ticket == NULL || reqType != MSG_TYPE_JOIN_REQUEST || ticket->position != 0 || reqId != ticket->reqId)
+        {
+            return;
+        }
+        ticket->isDeferred = 1;
+        ticket->resendTime = L3_timer_getMs() + retryMs;
+    }
+    else if ((reqType == MSG_TYPE_CONNECT_REQUEST || reqType == MSG_TYPE_JOIN_REQUEST) &&
+             isWaitingForBoothInfo && reqId == connectReqId)
+    {
+        isConnectDeferred = 1;
+        connectResendTime = L3_timer_getMs() + retryMs;
+    }
+    else if (reqType == MSG_TYPE_REGISTER_REQUEST && reqId == registerReqId &&
+             ((isWaitingForRegisterResponse && main_state == L3STATE_CONNECTED) ||
+              (isCallRegistering && main_state == L3STATE_WAITING)))
+    {
+        isRegisterDeferred = 1;
+        registerResendTime = L3_timer_getMs() + retryMs;
+    }
+    else
+    {
+        return;
+    }
+
+    pc.printf("\n[User] Booth %d is busy, waiting %d ms before asking again\n", srcId, retryMs);
+}
+
+// 대기열 정보 수신 (사용자 측)
+static void L3service_onQueueInfo(uint8_t srcId, uint8_t *msg, uint8_t size, int16_t rssi)
+{
+    uint8_t *msgData = L3_msg_getData(msg);
+    uint8_t newPosition = msgData[0];
+    uint8_t newTotal = msgData[1];
+    myEtaSec = L3_msg_getEta(msg, size, L3_QUEUEINFO_OFFSET_ETA);
+
+    // 중복 메시지 필터링
+    if (newPosition != lastQueuePosition || newTotal != lastTotalWaiting)
+    {
+        lastQueuePosition = newPosition;
+        lastTotalWaiting = newTotal;
+
+        // handleQueueInfo가 myWaitingNumber와 totalWaitingUsers를 설정함
+        handleQueueInfo(msgData);
+        printWaitingStatus();
+
+        // ** QUEUE_INFO만 받고 REGISTER_RESPONSE를 못받은 경우 대비 **
+        // QUEUE_INFO를 받았다는 것은 대기열에 있다는 것을 의미함
+        // 어떤 상태에서든 WAITING으로 전환
+        pc.printf("[DEBUG] Transitioning to WAITING state due to QUEUE_INFO\n");
+    }
+}
+
+// 부스 스캔 목록 초기화 (RSSI 스캔 초기화)
+static void initializeBoothScanList(void)
+{
+    for (uint8_t i = 0; i < MAX_BOOTHS; i++)
+    {
+        scannedBooths[i].boothId = 0;
+        scannedBooths[i].rssi = -127; // 초기 RSSI 최소값 설정
+        scannedBooths[i].currentCount = 0;
+        scannedBooths[i].capacity = 0;
+        scannedBooths[i].waitingCount = 0;
+        scannedBooths[i].etaSec = L3_ETA_UNKNOWN;
+        scannedBooths[i].lastSeenTime = 0;
+        scannedBooths[i].isValid = 0; // 유효하지 않은 상태로 초기화
+        scannedBooths[i].isVisited = 0;
+        infoCache[i].infoVersion = L3_INFOVER_NONE; // 설명 캐시 비움
+        infoCache[i].isAccepted = 0;
+        scannedBooths[i].rssiAvg = 0;
+        scannedBooths[i].rssiSamples = 0;
+    }
+}
+
+// SCANNING 으로 돌아왔을 때: 최근에 들은 미체험 부스가 있으면 스캔 없이 바로 선택, 없으면 방송 스캔
+static void resumeScanning(void)
+{
+    uint8_t nbFresh = 0;
+    for (uint8_t i = 0; i < MAX_BOOTHS; i++)
+    {
+        if (isBoothSelectable(&scannedBooths[i], L3_BOOTHTABLE_FRESHMS))
+        {
+            nbFresh++;
+        }
+    }
+
+    scanRetryCount = 0;
+    if (nbFresh == 0)
+    {
+        startBoothScan();
+        return;
+    }
+
+    // 선택 처리는 스캔 종료와 같은 경로 (L3service_run)
+    pc.printf("[User] %d booth(s) heard recently, selecting without scan\n", nbFresh);
+    isScanning = 1;
+    scanResponseCount = nbFresh;
+    L3_timer_boothSelectionStop();
+    L3_event_setEventFlag(L3_event_boothSelectionTimeout);
+}
+
+// 체험을 마친 (또는 이미 체험한) 부스는 다음 선택에서 제외
+static void markBoothVisited(uint8_t boothId)
+{
+    for (uint8_t i = 0; i < MAX_BOOTHS; i++)
+    {
+        if (scannedBooths[i].isValid && scannedBooths[i].boothId == boothId)
+        {
+            scannedBooths[i].isVisited = 1;
+            return;
+        }
+    }
+}
+
+// 부스에서 받은 메시지 RSSI 를 평균에 반영하고 평균 반환 (목록에 없으면 이번 값 그대로)
+static int16_t addBoothRssiSample(uint8_t boothId, int16_t rssi)
+{
+    for (uint8_t i = 0; i < MAX_BOOTHS; i++)
+    {
+        if (scannedBooths[i].isValid && scannedBooths[i].boothId == boothId)
+        {
+            L3_boothScore_addRssi(&scannedBooths[i], rssi);
+            return L3_boothScore_getRssi(&scannedBooths[i]);
+        }
+    }
+    return rssi;
+}
+
+// 선택 후보인지: 유효하고, 체험 전이고, maxAgeMs 안에 방송을 들었음
+static uint8_t isBoothSelectable(const BoothScanInfo_t *booth, uint32_t maxAgeMs)
+{
+    if (!booth->isValid || booth->isVisited)
+    {
+        return 0;
+    }
+
+    return (L3_timer_getMs() - booth->lastSeenTime) <= maxAgeMs;
+}
+
+// 응답 없는 스캔 재전송 (지연 실행용): 그사이 스캔을 그만뒀으면 보내지 않음
+static void resendBoothScan(void)
+{
+    if (main_state == L3STATE_SCANNING && isScanning)
+    {
+        startBoothScan();
+    }
+}
+
+// 방송 스캔 한 번 전송: 응답 창 정보를 담아 보내고 창이 끝나는 시점에 선택 타이머 설정
+static void startBoothScan(void)
+{
+    isScanning = 1;
+    isRescanScheduled = 0;
+    scanResponseCount = 0;
+    scanStartTime = L3_timer_getMs();
+
+    uint8_t scanMsg[L3_MSG_OFFSET_DATA + L3_SCAN_OFFSET_SLOTLEN + 1];
+    uint8_t msgSize = L3_msg_encodeBoothScan(scanMsg, L3_SCAN_NBSLOTS, L3_SCAN_SLOTMS);
+    L3_LLI_dataReqFunc(scanMsg, msgSize, BROADCAST_ID);
+
+    L3_timer_boothSelectionStart(SCAN_WINDOW_MS);
+}
+
+// 방송을 들을 때마다 부스 목록 갱신 (RSSI, 인원, 마지막으로 들은 시각)
+//   - 이번 스캔 시작 이후 처음 들은 부스면 1 반환
+static uint8_t updateBoothScanInfo(uint8_t boothId, int16_t rssi, uint8_t currentCount,
+                                   uint8_t capacity, uint8_t waitingCount, uint16_t etaSec)
+{
+    uint32_t now = L3_timer_getMs();
+    BoothScanInfo_t *entry = NULL;
+
+    // 같은 부스 항목, 없으면 빈 항목, 그것도 없으면 가장 오래 못 들은 항목을 재사용
+    for (uint8_t i = 0; i < MAX_BOOTHS && entry == NULL; i++)
+    {
+        if (scannedBooths[i].isValid && scannedBooths[i].boothId == boothId)
+        {
+            entry = &scannedBooths[i];
+        }
+    }
+    for (uint8_t i = 0; i < MAX_BOOTHS && entry == NULL; i++)
+    {
+        if (!scannedBooths[i].isValid)
+        {
+            entry = &scannedBooths[i];
+        }
+    }
+    if (entry == NULL)
+    {
+        entry = &scannedBooths[0];
+        for (uint8_t i = 1; i < MAX_BOOTHS; i++)
+        {
+            if ((now - scannedBooths[i].lastSeenTime) > (now - entry->lastSeenTime))
+            {
+                entry = &scannedBooths[i];
+            }
+        }
+    }
+
+    uint8_t isNew = !entry->isValid || entry->boothId != boothId ||
+                    (int32_t)(entry->lastSeenTime - scanStartTime) < 0;
+    if (!entry->isValid || entry->boothId != boothId)
+    {
+        entry->isVisited = 0;
+        entry->rssiSamples = 0;
+    }
+    L3_boothScore_addRssi(entry, rssi);
+
+    entry->boothId = boothId;
+    entry->rssi = rssi;
+    entry->currentCount = currentCount;
+    entry->capacity = capacity;
+    entry->waitingCount = waitingCount;
+    entry->etaSec = etaSec;
+    entry->lastSeenTime = now;
+    entry->isValid = 1; // 유효 플래그 설정
+    return isNew;
+}
+
+// 최적 부스 선정: 점수는 L3_boothScore 정책 (평균 RSSI, 빈 자리, 예상 대기)
+//   - 직전에 고른 부스가 후보에 있으면, 다른 부스는 히스테리시스 이상 앞서야 바뀜
+static uint8_t selectOptimalBooth(void)
+{
+    uint8_t bestBoothId = 0;
+    int32_t bestScore = 0;
+    uint8_t hasPreferred = 0;
+    int32_t preferredScore = 0;
+
+    pc.printf("\n[User] Analyzing booth options...\n");
+
+    for (uint8_t i = 0; i < MAX_BOOTHS; i++)
+    {
+        // 오래 못 들은 부스, 이미 체험한 부스는 제외
+        if (!isBoothSelectable(&scannedBooths[i], L3_BOOTHTABLE_EXPIRYMS))
+        {
+            continue;
+        }
+
+        int32_t score = L3_boothScore_score(&scannedBooths[i]);
+
+        pc.printf("  Booth %d: RSSI avg=%d (%d samples), Score=%d (Users=%d/%d, Queue=%d, Wait~%d s)\n",
+                  scannedBooths[i].boothId, L3_boothScore_getRssi(&scannedBooths[i]),
+                  scannedBooths[i].rssiSamples, score,
+                  scannedBooths[i].currentCount, scannedBooths[i].capacity,
+                  scannedBooths[i].waitingCount,
+                  L3_boothScore_predictWaitMs(&scannedBooths[i]) / 1000);
+
+        if (bestBoothId == 0 || score > bestScore)
+        {
+            bestScore = score;
+            bestBoothId = scannedBooths[i].boothId;
+        }
+        if (scannedBooths[i].boothId == preferredBoothId)
+        {
+            hasPreferred = 1;
+            preferredScore = score;
+        }
+    }
+
+    // 점수가 비슷하면 직전 선택 유지 (부스 사이를 오가지 않도록)
+    if (hasPreferred && bestBoothId != preferredBoothId &&
+        bestScore - preferredScore < L3_boothScore_getWeights()->hysteresis)
+    {
+        pc.printf("  Keeping Booth %d (Booth %d is only %d point(s) better)\n",
+                  preferredBoothId, bestBoothId, bestScore - preferredScore);
+        bestBoothId = preferredBoothId;
+    }
+
+    if (bestBoothId != 0)
+    {
+        preferredBoothId = bestBoothId;
+    }
+
+    return bestBoothId; // 최적 부스 ID 반환 (없으면 0)
+}
+
+// 디버그용으로 스캔된 모든 부스 출력 (디버그용 스캔 결과 출력)
+static void displayScannedBooths(void)
+{
+    pc.printf("\n=== SCANNED BOOTHS (RSSI-based) ===\n");
+    uint8_t foundCount = 0;
+
+    uint32_t now = L3_timer_getMs();
+    for (uint8_t i = 0; i < MAX_BOOTHS; i++)
+    {
+        if (scannedBooths[i].isValid)
+        {
+            pc.printf("Booth %d: RSSI=%d dBm, Users=%d/%d, Waiting=%d, heard %d ms ago%s\n",
+                      scannedBooths[i].boothId,
+                      scannedBooths[i].rssi,
+                      scannedBooths[i].currentCount,
+                      scannedBooths[i].capacity,
+                      scannedBooths[i].waitingCount,
+                      now - scannedBooths[i].lastSeenTime,
+                      scannedBooths[i].isVisited ? " (visited)" : "");
+            foundCount++;
+        }
+    }
+
+    if (foundCount == 0)
+    {
+        pc.printf("No booths detected.\n");
+    }
+    pc.printf("===================================\n");
+}
+
+// 요청별 전송 결과 (L2 DATA_CNF): 전송 실패 시 타임아웃을 기다리지 않고 바로 재시도
+void L3service_onDataCnf(uint8_t handle, uint8_t res)
+{
+    if (handle == connectReqHandle)
+    {
+        connectReqHandle = 0;
+        if (!res && isWaitingForBoothInfo && main_state == L3STATE_CONNECTED)
+        {
+            // 응답 타임아웃을 기다리지 않고 지터 백오프만 두고 재시도
+            pc.printf("\n[User] Connect request not delivered\n");
+            isConnectDeferred = 0;
+            connectRetryTime = L3_timer_getMs() + L2_backoff_jitterMs(L3_RETRY_BASEMS, L3_RETRY_CAPMS, connectRetryCount);
+        }
+    }
+    else if (handle == registerReqHandle)
+    {
+        registerReqHandle = 0;
+        if (!res && isWaitingForRegisterResponse && main_state == L3STATE_CONNECTED)
+        {
+            pc.printf("\n[User] Registration request not delivered\n");
+            isRegisterDeferred = 0;
+            registerRetryTime = L3_timer_getMs() + L2_backoff_jitterMs(L3_RETRY_BASEMS, L3_RETRY_CAPMS, registerRetryCount);
+        }
+    }
+}
+
+// 빠른 입장 가능 여부: 부스 정보 확인 단계를 생략해도 되는지 (부스별)
+//   - 사용자가 미리 입장에 동의했거나 ('j')
+//   - 이 부스의 설명을 캐시하고 있고 그 설명에 이미 'y' 로 동의함
+//     (캐시는 최근 방송의 정보 버전과 다르면 폐기되므로 남아 있으면 지금 설명과 같음)
+static uint8_t canFastJoin(uint8_t boothId)
+{
+    if (autoJoin)
+    {
+        return 1;
+    }
+
+    BoothInfoCache_t *cached = findCachedInfo(boothId);
+    if (cached != NULL && cached->isAccepted)
+    {
+        pc.printf("Booth %d: %s (already accepted)\n", boothId, cached->description);
+        return 1;
+    }
+    return 0;
+}
+
+// 부스에 연결 시작 (CONNECTED 로 전이)
+static void connectToBooth(uint8_t boothId)
+{
+    currentBoothId = boothId;
+    pc.printf("Connecting to Booth %d...\n", currentBoothId);
+
+    // 연결 시도 상태 초기화 (재시도 카운터, 대기 플래그, 재스캔 백오프)
+    connectRetryCount = 0;
+    rescanCount = 0;
+    isWaitingForBoothInfo = 1;
+
+    // 사전 동의한 경우 BOOTH_INFO / y 응답 / REGISTER 를 건너뛰고 JOIN 한 번으로 입장
+    isJoinRequest = canFastJoin(currentBoothId);
+    connectReqId = newReqId();
+    if (isJoinRequest)
+    {
+        pc.printf("Fast join: requesting entry directly...\n");
+    }
+
+    sendConnectRequest();
+    main_state = L3STATE_CONNECTED; // 상태 전이: CONNECTED
+}
+
+// 안내받은 부스로 이동: 지금 대기열을 떠나고 (QUEUE_LEAVE) 새 부스에 연결
+static void moveToOfferedBooth(void)
+{
+    uint8_t boothId = offerBoothId;
+    offerBoothId = 0;
+
+    pc.printf("\nLeaving the queue of Booth %d for Booth %d...\n", currentBoothId, boothId);
+    sendMessage(MSG_TYPE_QUEUE_LEAVE, NULL, 0, currentBoothId);
+
+    isReserved = 0;
+    isFarNotified = 0;
+    isCallRegistering = 0;
+    myWaitingNumber = 0;
+    totalWaitingUsers = 0;
+
+    connectToBooth(boothId);
+}
+
+// 부스의 대기표 (없으면 NULL)
+static VirtualTicket_t *findTicket(uint8_t boothId)
+{
+    for (uint8_t i = 0; i < L3_TICKET_MAX; i++)
+    {
+        if (boothId != 0 && tickets[i].boothId == boothId)
+        {
+            return &tickets[i];
+        }
+    }
+    return NULL;
+}
+
+// 빈 대기표가 있으면 최근에 들은 다른 미체험 부스에 JOIN_REQUEST (응답이 없던 요청은 다시 보냄)
+static void requestTickets(void)
+{
+    if (!isTicketMode || main_state != L3STATE_WAITING)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < L3_TICKET_MAX; i++)
+    {
+        if (tickets[i].boothId != 0 && tickets[i].position == 0 && !tickets[i].isDeferred)
+        {
+            sendTicketRequest(&tickets[i]);
+        }
+    }
+
+    for (uint8_t b = 0; b < MAX_BOOTHS && nbTickets < L3_TICKET_MAX; b++)
+    {
+        uint8_t boothId = scannedBooths[b].boothId;
+        if (!isBoothSelectable(&scannedBooths[b], L3_BOOTHTABLE_FRESHMS) ||
+            boothId == currentBoothId || findTicket(boothId) != NULL)
+        {
+            continue;
+        }
+
+        for (uint8_t i = 0; i < L3_TICKET_MAX; i++)
+        {
+            if (tickets[i].boothId == 0)
+            {
+                tickets[i].boothId = boothId;
+                tickets[i].position = 0;
+                tickets[i].reqId = newReqId();
+                tickets[i].isDeferred = 0;
+                tickets[i].totalWaiting = 0;
+                tickets[i].etaSec = L3_ETA_UNKNOWN;
+                nbTickets++;
+
+                pc.printf("[Ticket] Requesting a place at Booth %d too\n", boothId);
+                sendTicketRequest(&tickets[i]);
+                break;
+            }
+        }
+    }
+}
+
+// 대기표 JOIN_REQUEST 전송 (대기표마다 요청 ID 하나, 관리자는 재전송에 캐시한 응답으로 답함)
+static void sendTicketRequest(VirtualTicket_t *ticket)
+{
+    ticket->isDeferred = 0;
+
+    uint8_t reqData[1];
+    reqData[L3_JOINREQ_OFFSET_REQID] = ticket->reqId;
+    sendMessage(MSG_TYPE_JOIN_REQUEST, reqData, 1, ticket->boothId);
+}
+
+// keepBoothId 외의 모든 대기표 반납 (QUEUE_LEAVE)
+static void withdrawTickets(uint8_t keepBoothId)
+{
+    for (uint8_t i = 0; i < L3_TICKET_MAX; i++)
+    {
+        if (tickets[i].boothId != 0 && tickets[i].boothId != keepBoothId)
+        {
+            pc.printf("[Ticket] Leaving the queue of Booth %d\n", tickets[i].boothId);
+            sendMessage(MSG_TYPE_QUEUE_LEAVE, NULL, 0, tickets[i].boothId);
+        }
+        tickets[i].boothId = 0;
+    }
+    nbTickets = 0;
+}
+
+// 지금 부스 대기열에서 빠졌을 때 가장 앞선 대기표의 부스 대기를 이어감 (있으면 1)
+static uint8_t promoteTicket(void)
+{
+    VirtualTicket_t *best = NULL;
+    for (uint8_t i = 0; i < L3_TICKET_MAX; i++)
+    {
+        if (tickets[i].boothId != 0 && tickets[i].position != 0 &&
+            (best == NULL || tickets[i].position < best->position))
+        {
+            best = &tickets[i];
+        }
+    }
+    if (best == NULL)
+    {
+        return 0;
+    }
+
+    pc.printf("\n[Ticket] Removed from Booth %d, continuing in the queue of Booth %d\n", currentBoothId, best->boothId);
+    currentBoothId = best->boothId;
+    myWaitingNumber = best->position;
+    totalWaitingUsers = best->totalWaiting;
+    myEtaSec = best->etaSec;
+    hasSnapshotVersion = 0;
+
+    best->boothId = 0;
+    nbTickets--;
+    printWaitingStatus();
+    return 1;
+}
+
+// 대기표 부스가 먼저 부름: 지금 부스와 나머지 대기표 대기열을 떠나고 그 부스를 현재 부스로
+static void switchToTicketBooth(uint8_t boothId)
+{
+    pc.printf("\n[Ticket] Booth %d called first, leaving the queue of Booth %d\n", boothId, currentBoothId);
+    sendMessage(MSG_TYPE_QUEUE_LEAVE, NULL, 0, currentBoothId);
+    withdrawTickets(boothId);
+
+    currentBoothId = boothId;
+    isReserved = 0;
+    isFarNotified = 0;
+    isCallRegistering = 0;
+    offerBoothId = 0;
+    hasSnapshotVersion = 0;
+}
+
+// CONNECT_REQUEST (빠른 입장이면 JOIN_REQUEST) 전송 및 응답 대기 타이머 재시작
+//   - 설명을 캐시하고 있으면 버전을 실어 보내 설명 없는 응답을 받음
+static void sendConnectRequest(void)
+{
+    isConnectDeferred = 0;
+    connectRetryTime = L3_timer_getMs() + CONNECT_TIMEOUT_MS +
+                       L2_backoff_jitterMs(L3_RETRY_BASEMS, L3_RETRY_CAPMS, connectRetryCount);
+    if (isJoinRequest)
+    {
+        uint8_t reqData[1];
+        reqData[L3_JOINREQ_OFFSET_REQID] = connectReqId;
+        connectReqHandle = sendMessage(MSG_TYPE_JOIN_REQUEST, reqData, 1, currentBoothId);
+        return;
+    }
+
+    BoothInfoCache_t *cached = findCachedInfo(currentBoothId);
+    uint8_t requestMsg[3];
+    uint8_t msgSize = L3_msg_encodeConnectRequest(requestMsg, cached ? cached->infoVersion : L3_INFOVER_NONE, connectReqId);
+    connectReqHandle = L3_LLI_dataReqFunc(requestMsg, msgSize, currentBoothId);
+}
+
+// 부스 설명 캐시 검색 (없으면 NULL)
+static BoothInfoCache_t *findCachedInfo(uint8_t boothId)
+{
+    for (uint8_t i = 0; i < MAX_BOOTHS; i++)
+    {
+        if (infoCache[i].infoVersion != L3_INFOVER_NONE && infoCache[i].boothId == boothId)
+        {
+            return &infoCache[i];
+        }
+    }
+    return NULL;
+}
+
+// 부스 설명 캐시 저장: 같은 부스 항목, 없으면 빈 항목, 그것도 없으면 첫 항목을 덮어씀
+static void storeCachedInfo(uint8_t boothId, uint8_t infoVersion, const char *description)
+{
+    BoothInfoCache_t *entry = findCachedInfo(boothId);
+    for (uint8_t i = 0; i < MAX_BOOTHS && entry == NULL; i++)
+    {
+        if (infoCache[i].infoVersion == L3_INFOVER_NONE)
+        {
+            entry = &infoCache[i];
+        }
+    }
+    if (entry == NULL)
+    {
+        entry = &infoCache[0];
+    }
+
+    if (entry->boothId != boothId || entry->infoVersion != infoVersion)
+    {
+        entry->isAccepted = 0;
+    }
+    entry->boothId = boothId;
+    entry->infoVersion = infoVersion;
+    strncpy(entry->description, description, L3_BOOTH_DESCSIZE - 1);
+    entry->description[L3_BOOTH_DESCSIZE - 1] = '\0';
+}
+
+// 연결 재시도, 최대 횟수 초과 시 스캔 모드로 복귀
+static void retryConnectRequest(const char *reason)
+{
+    if (connectRetryCount < CONNECT_RETRY_MAX)
+    {
+        connectRetryCount++;
+        pc.printf("\n[User] %s. Retrying... (%d/%d)\n", reason,
+                  connectRetryCount, CONNECT_RETRY_MAX);
+
+        // 재전송 요청
+        sendConnectRequest();
+    }
+    else
+    {
+        pc.printf("\n[User] Failed to connect to booth after %d attempts.\n",
+                  CONNECT_RETRY_MAX);
+        pc.printf("Returning to scanning mode...\n");
+
+        // 초기화 후 스캔 모드로 복귀
+        main_state = L3STATE_SCANNING;
+        currentBoothId = 0;
+        connectRetryCount = 0;
+        connectReqHandle = 0;
+        isWaitingForBoothInfo = 0;
+        isJoinRequest = 0;
+        resumeScanning();
+    }
+}
+
+// USER_RESPONSE(YES) + REGISTER_REQUEST 전송 (L2 큐에서 순서대로 전송됨)
+//   - 재시도는 USER_RESPONSE 없이 같은 요청 ID 의 REGISTER_REQUEST 만 다시 보냄 (관리자는 캐시한 응답으로 답함)
+static void sendRegisterRequest(uint8_t isRetry)
+{
+    if (!isRetry)
+    {
+        uint8_t responseMsg[2];
+        L3_msg_encodeUserResponse(responseMsg, USER_RESPONSE_YES);
+        L3_LLI_dataReqFunc(responseMsg, 2, currentBoothId);
+
+        registerReqId = newReqId();
+    }
+
+    isRegisterDeferred = 0;
+    registerRetryTime = L3_timer_getMs() + REGISTER_TIMEOUT_MS +
+                        L2_backoff_jitterMs(L3_RETRY_BASEMS, L3_RETRY_CAPMS, registerRetryCount);
+
+    uint8_t reqData[1];
+    reqData[L3_REGISTER_OFFSET_REQID] = registerReqId;
+    registerReqHandle = sendMessage(MSG_TYPE_REGISTER_REQUEST, reqData, 1, currentBoothId);
+}
+
+// 입장 호출 (QUEUE_READY / 예약 시간 초과) 에 대한 REGISTER_REQUEST 전송 (USER_RESPONSE 없음)
+//   - 같은 호출 안의 재전송 (관리자 재호출, BUSY) 은 같은 요청 ID 로 보냄 (관리자는 캐시한 응답으로 답함)
+static void sendCallRegisterRequest(void)
+{
+    if (!isCallRegistering)
+    {
+        isCallRegistering = 1;
+        registerReqId = newReqId();
+    }
+    isRegisterDeferred = 0;
+
+    uint8_t reqData[1];
+    reqData[L3_REGISTER_OFFSET_REQID] = registerReqId;
+    sendMessage(MSG_TYPE_REGISTER_REQUEST, reqData, 1, currentBoothId);
+}
+
+// 새 연결/등록 시도의 요청 ID (L3_REQID_NONE 은 건너뜀)
+static uint8_t newReqId(void)
+{
+    lastReqId++;
+    if (lastReqId == L3_REQID_NONE)
+    {
+        lastReqId++;
+    }
+    return lastReqId;
+}
+
+// 등록 재시도, 최대 횟수 초과 시 스캔 모드로 복귀
+static void retryRegisterRequest(const char *reason)
+{
+    if (registerRetryCount < REGISTER_RETRY_MAX)
+    {
+        registerRetryCount++;
+        pc.printf("\n[User] %s. Retrying... (%d/%d)\n", reason,
+                  registerRetryCount, REGISTER_RETRY_MAX);
+
+        sendRegisterRequest(1);
+    }
+    else
+    {
+        pc.printf("\n[User] Failed to register after %d attempts.\n",
+                  REGISTER_RETRY_MAX);
+        pc.printf("Returning to scanning mode...\n");
+
+        // 초기화 후 스캔 모드로 복귀
+        main_state = L3STATE_SCANNING;
+        currentBoothId = 0;
+        registerRetryCount = 0;
+        registerReqHandle = 0;
+        isWaitingForRegisterResponse = 0;
+        resumeScanning();
+    }
+}
+
+// Helper Functions
+static uint8_t sendMessage(uint8_t msgType, uint8_t *data, uint8_t dataLen, uint8_t destId)
+{
+    txBuffer[0] = msgType;
+    if (data && dataLen > 0)
+    {
+        memcpy(txBuffer + 1, data, dataLen);
+    }
+
+    // 주기적 메시지가 아닌 경우 디버그 출력
+    if (msgType != MSG_TYPE_BOOTH_ANNOUNCE)
+    {
+        //pc.printf("[DEBUG] Sending message type 0x%02X to ID %d (size: %d)\n", msgType, destId, dataLen + 1);
+    }
+
+    return L3_LLI_dataReqFunc(txBuffer, dataLen + 1, destId);
+}
+
+// 부스 정보 안내 (현재 이용자 수, 정원, 대기 인원, 설명) 후 체험 여부 질문
+static void handleBoothInfo(uint8_t currentUsers, uint8_t capacity, uint8_t waitingUsers, const char *description)
+{
+    pc.printf("\n=== BOOTH INFORMATION ===\n");
+    pc.printf("Description: %s\n", description);
+    pc.printf("Current users: %d/%d\n", currentUsers, capacity);
+    pc.printf("Waiting users: %d\n", waitingUsers);
+    pc.printf("Session duration: %d seconds\n", SESSION_DURATION_MS / 1000); // 신규: 세션 정보 안내
+    pc.printf("\nWould you like to experience this booth? (y/n): ");
+
+    // 사용자 입력 대기: Y/N 응답에 따라 다음 상태로 전이
+    // C1, C2 조건에 따라 CONNECTED → SCANNING/WAITING/IN_USE 전이
+    L3_event_setEventFlag(L3_event_keyboardInput);
+    // 키보드 입력 핸들러에서 상태 전이 처리
+}
+
+static void handleRegisterResponse(uint8_t *data)
+{
+    uint8_t success = data[0];
+    uint8_t reason = data[1];
+
+    isReserved = 0; // 예약 입장도 REGISTER_RESPONSE 로 끝남
+    isFarNotified = 0;
+    isCallRegistering = 0;
+    offerBoothId = 0;
+
+    if (success)
+    {
+        pc.printf("\nRegistration successful! Welcome to the booth!\n");
+        pc.printf("Your experience session has started.\n");
+        pc.printf("Session duration: %d seconds\n", SESSION_DURATION_MS / 1000); // 신규: 세션 정보 안내
+        pc.printf("Press 'e' to exit the booth early.\n");
+        pc.printf("Press 'c' to chat with other users in the booth.\n");  // 채팅 안내 추가
+        main_state = L3STATE_IN_USE; // CONNECTED → IN_USE (!C1 & C2 조건 만족)
+
+        // 부스 그룹 수신 시작 (입장 이후 프레임부터)
+        L3_group_initReceiver(currentBoothId);
+
+        // 사용자 측 세션 타이머 시작
+        isSessionActive = 1;
+        sessionStartTime = us_ticker_read() / 1000; // ms 단위 저장
+    }
+    else
+    {
+        if (reason == REGISTER_REASON_ALREADY_USED)
+        {
+            pc.printf("\nRegistration failed: You have already experienced this booth.\n");
+            pc.printf("Each user can only experience a booth once.\n");
+            pc.printf("Returning to scanning mode...\n");
+
+            // 이미 등록된 사용자는 재등록 불가 (C2 위반), CONNECTED → SCANNING 전이
+            markBoothVisited(currentBoothId);
+            main_state = L3STATE_SCANNING;
+            currentBoothId = 0;
+
+            // 다른 부스 선택
+            resumeScanning();
+        }
+        else if (reason == REGISTER_REASON_QUEUE_FULL)
+        {
+            pc.printf("\nRegistration failed: Booth and waiting queue are both full.\n");
+            pc.printf("Returning to scanning mode...\n");
+
+            // 대기열에도 들어갈 수 없음, CONNECTED → SCANNING 전이
+            main_state = L3STATE_SCANNING;
+            currentBoothId = 0;
+
+            // 다른 부스 선택
+            resumeScanning();
+        }
+        else if (reason == REGISTER_REASON_FULL_WAITING)
+        {
+            pc.printf("\nBooth is full. You have been added to the waiting queue.\n");
+            // 부스가 만원(C1)이고 대기열에 등록된 상태(C3) → CONNECTED → WAITING 전이
+            main_state = L3STATE_WAITING;
+            hasSnapshotVersion = 0; // 이 부스의 스냅샷 버전부터 새로 따라감
+            // 곧 QUEUE_INFO 메시지를 통해 순번 정보를 수신함
+        }
+    }
+}
+
+static void handleQueueInfo(uint8_t *data)
+{
+    myWaitingNumber = data[0];
+    totalWaitingUsers = data[1];
+    main_state = L3STATE_WAITING;
+}
+
+static void printWaitingStatus()
+{
+    pc.printf("\nYou are in the waiting queue.\n");
+    pc.printf("Your position: %d/%d\n", myWaitingNumber, totalWaitingUsers);
+    if (myEtaSec != L3_ETA_UNKNOWN)
+    {
+        pc.printf("Estimated time to admission: about %d min %d sec\n", myEtaSec / 60, myEtaSec % 60);
+    }
+    pc.printf("Please stay near the booth to enter when your turn arrives.\n");
+    pc.printf("If you don't, you will be removed from the waiting queue.\n");
+    pc.printf("Press 'e' to leave the queue.\n");
+}
+
+// 사용자 명령을 처리하는 키보드 입력 핸들러
+static void L3service_processKeyboardInput(void)
+{
+    char c = pc.getc();
+
+    // 채팅 입력 중인 경우 - 모든 키 입력을 채팅으로 처리
+    if (isTypingChat)
+    {
+        if (c == '\r' || c == '\n')
+        {
+            // 채팅 메시지 전송
+            chatBuffer[chatIndex] = '\0';
+            
+            pc.printf("\n");
+            if (chatIndex > 0)
+            {
+                // 전송은 메인 루프에서 (전송 버퍼를 메인 루프와 같이 씀), 보낼 때까지 새 입력은 받지 않음
+                isChatReady = 1;
+            }
+            else
+            {
+                chatIndex = 0;  // 빈 메시지는 보내지 않음
+            }
+
+            // 채팅 입력 상태 초기화
+            isTypingChat = 0;
+        }
+        else if (c == '\b' || c == 127)
+        {
+            // 백스페이스 처리
+            if (chatIndex > 0)
+            {
+                chatIndex--;
+                pc.printf("\b \b");
+            }
+        }
+        else if (c == 27)  // ESC 키로 채팅 취소
+        {
+            pc.printf("\n[Chat cancelled]\n");
+            isTypingChat = 0;
+            chatIndex = 0;
+        }
+        else if (chatIndex < 100)
+        {
+            // 채팅 버퍼에 문자 추가 (e 포함 모든 문자)
+            chatBuffer[chatIndex++] = c;
+            pc.putc(c);
+        }
+        return;  // 채팅 모드에서는 다른 명령 처리 안함
+    }
+
+    // 부스 선택 응답 처리 (CONNECTED 상태에서)
+    if (L3_event_checkEventFlag(L3_event_keyboardInput) && main_state == L3STATE_CONNECTED)
+    {
+        if ((c == 'y' || c == 'Y') && keyCommand == KEYCMD_NONE)
+        {
+            pc.printf("y\n");
+            keyCommand = KEYCMD_ACCEPT;
+        }
+        else if ((c == 'n' || c == 'N') && keyCommand == KEYCMD_NONE)
+        {
+            pc.printf("n\n");
+            keyCommand = KEYCMD_DECLINE;
+        }
+        return;
+    }
+
+    // 일반 명령 처리 (채팅 모드가 아닐 때만)
+
+    // 빠른 입장 전환 ('j' 키) - 다음 부스 연결부터 적용
+    if (c == 'j' || c == 'J')
+    {
+        autoJoin = !autoJoin;
+        pc.printf("\nFast join %s\n", autoJoin ? "ON (booths are entered without the info prompt)" : "OFF");
+        return;
+    }
+
+    // 가상 대기표 전환 ('v' 키) - 다음 대기부터 적용, 끄면 메인 루프에서 대기표 반납
+    if (c == 'v' || c == 'V')
+    {
+        isTicketMode = !isTicketMode;
+        pc.printf("\nVirtual tickets %s", isTicketMode ? "ON" : "OFF\n");
+        if (isTicketMode)
+        {
+            pc.printf(" (also queue at up to %d other booth(s) while waiting)\n", L3_TICKET_MAX);
+        }
+        return;
+    }
+
+    // 다른 부스 안내 수락 ('x' 키) - WAITING 상태에서 안내를 받았을 때만
+    if ((c == 'x' || c == 'X') && main_state == L3STATE_WAITING && offerBoothId != 0)
+    {
+        isOfferAccepted = 1;
+        return;
+    }
+
+    // 채팅 시작 ('c' 키) - IN_USE 상태에서만 가능
+    if ((c == 'c' || c == 'C') && main_state == L3STATE_IN_USE && !isTypingChat && !isChatReady)
+    {
+        pc.printf("\nEnter chat message (max 100 chars, ESC to cancel): ");
+        isTypingChat = 1;
+        chatIndex = 0;
+        return;
+    }
+
+    // 종료 명령 처리 ('e' 키): 부스에서 나가기 또는 대기열 탈퇴
+    if ((c == 'e' || c == 'E') && !isTypingChat && keyCommand == KEYCMD_NONE &&
+        (main_state == L3STATE_IN_USE || main_state == L3STATE_WAITING))
+    {
+        keyCommand = KEYCMD_EXIT;
+    }
+}
+
+// 키보드 명령 실행 (메인 루프): ISR 에서 기록한 뒤 상태가 바뀌었으면 무시
+static void runKeyCommand(uint8_t command)
+{
+    if (command == KEYCMD_ACCEPT || command == KEYCMD_DECLINE)
+    {
+        if (main_state != L3STATE_CONNECTED || !L3_event_checkEventFlag(L3_event_keyboardInput))
+        {
+            return;
+        }
+        L3_event_clearEventFlag(L3_event_keyboardInput);
+
+        if (command == KEYCMD_ACCEPT)
+        {
+            // 같은 설명이면 다음 연결부터 확인 없이 빠른 입장
+            BoothInfoCache_t *cached = findCachedInfo(currentBoothId);
+            if (cached != NULL)
+            {
+                cached->isAccepted = 1;
+            }
+
+            // USER_RESPONSE YES + REGISTER_REQUEST 전송 (부스 체험 의사 표시 및 등록 요청)
+            pc.printf("Sending registration request...\n");
+            sendRegisterRequest(0);
+
+            // 등록 응답 대기 상태 설정
+            registerRetryCount = 0;
+            isWaitingForRegisterResponse = 1;
+        }
+        else
+        {
+            // USER_RESPONSE NO 전송 (부스 체험 거부)
+            uint8_t responseMsg[2];
+            L3_msg_encodeUserResponse(responseMsg, USER_RESPONSE_NO);
+            L3_LLI_dataReqFunc(responseMsg, 2, currentBoothId);
+
+            pc.printf("Declined. Returning to scanning mode...\n");
+            main_state = L3STATE_SCANNING; // CONNECTED → SCANNING
+            currentBoothId = 0;
+
+            // 다른 부스 선택
+            resumeScanning();
+        }
+    }
+    else if (command == KEYCMD_EXIT)
+    {
+        if (main_state == L3STATE_IN_USE)
+        {
+            // 세션 종료 시간 계산 및 표시 (사용자 측)
+            if (isSessionActive)
+            {
+                uint32_t sessionDuration = (us_ticker_read() / 1000) - sessionStartTime;
+                pc.printf("\nExiting booth... Session duration: %d seconds\n", sessionDuration / 1000);
+                isSessionActive = 0;
+                sessionStartTime = 0;
+            }
+
+            // EXIT_REQUEST 전송 (관리자에게 퇴장 요청)
+            sendMessage(MSG_TYPE_EXIT_REQUEST, NULL, 0, currentBoothId);
+
+            pc.printf("Exit request sent. Waiting for confirmation...\n");
+        }
+        else if (main_state == L3STATE_WAITING)
+        {
+            // 대기열 탈퇴 요청 (QUEUE_LEAVE 를 보낸 뒤 재스캔)
+            pc.printf("\nLeaving waiting queue...\n");
+            pc.printf("Sending QUEUE_LEAVE to booth %d\n", currentBoothId);
+            sendMessage(MSG_TYPE_QUEUE_LEAVE, NULL, 0, currentBoothId);
+
+            isReserved = 0;
+            isFarNotified = 0;
+            isCallRegistering = 0;
+            offerBoothId = 0;
+            pc.printf("Left the queue. Returning to scanning mode...\n");
+            main_state = L3STATE_SCANNING; // WAITING → SCANNING
+            currentBoothId = 0;
+            myWaitingNumber = 0;
+            totalWaitingUsers = 0;
+
+            // 다른 부스 선택
+            resumeScanning();
+        }
+    }
+}
+
+// 입력을 마친 채팅 메시지 전송 (메인 루프)
+static void sendChatInput(void)
+{
+    if (main_state == L3STATE_IN_USE)
+    {
+        uint8_t chatMsg[110];
+        uint8_t msgSize = L3_msg_encodeChatMessage(chatMsg, chatBuffer);
+        L3_LLI_dataReqFunc(chatMsg, msgSize, currentBoothId);
+
+        pc.printf("[Chat] You: %s\n", chatBuffer);
+    }
+
+    chatIndex = 0;
+    isChatReady = 0;
+}
@@ -0,0 +1,105 @@
+#include "mbed.h"
+#include "L3_waitModel.h"
+#include "L3_msg.h"
+#include "L3_role.h"
+#include "protocol_parameters.h"
+
+static uint32_t avgSessionMs = SESSION_DURATION_MS;
+static uint32_t avgAdmissionMs = L3_WAITMODEL_ADMISSIONMS;
+
+
+// 이동 평균: 새 샘플에 1/2^shift 가중
+static uint32_t movingAverage(uint32_t avg, uint32_t sample, uint8_t shift)
+{
+    int32_t diff = (int32_t)sample - (int32_t)avg;
+    return (uint32_t)((int32_t)avg + diff / (1 << shift));
+}
+
+void L3_waitModel_init(void)
+{
+    avgSessionMs = SESSION_DURATION_MS;
+    avgAdmissionMs = L3_WAITMODEL_ADMISSIONMS;
+}
+
+void L3_waitModel_addSession(uint32_t durationMs)
+{
+    if (durationMs > SESSION_DURATION_MS)
+    {
+        durationMs = SESSION_DURATION_MS;
+    }
+    avgSessionMs = movingAverage(avgSessionMs, durationMs, L3_WAITMODEL_ALPHA);
+}
+
+void L3_waitModel_addAdmission(uint32_t latencyMs)
+{
+    avgAdmissionMs = movingAverage(avgAdmissionMs, latencyMs, L3_WAITMODEL_ALPHA);
+}
+
+uint32_t L3_waitModel_getSessionMs(void)
+{
+    return avgSessionMs;
+}
+
+uint32_t L3_waitModel_getAdmissionMs(void)
+{
+    return avgAdmissionMs;
+}
+
+uint32_t L3_waitModel_estimateMs(uint8_t position, const uint32_t *elapsedMs, uint8_t nbActive, uint8_t capacity)
+{
+    uint32_t releaseMs[MAX_BOOTH_CAPACITY];
+
+    if (capacity == 0 || position == 0)
+    {
+        return 0;
+    }
+    if (capacity > MAX_BOOTH_CAPACITY)
+    {
+        capacity = MAX_BOOTH_CAPACITY;
+    }
+
+    // 자리별로 비기까지 남은 시간: 빈 자리는 0, 진행 중인 세션은 평균 길이 (최대 세션 시간 이내) 까지 남은 시간
+    for (uint8_t i = 0; i < capacity; i++)
+    {
+        releaseMs[i] = 0;
+        if (i >= nbActive)
+        {
+            continue;
+        }
+
+        if (elapsedMs[i] < avgSessionMs)
+        {
+            releaseMs[i] = avgSessionMs - elapsedMs[i];
+        }
+        else if (elapsedMs[i] < SESSION_DURATION_MS)
+        {
+            // 평균보다 오래 머무는 중: 최대 세션 시간까지 남은 시간의 절반으로 봄
+            releaseMs[i] = (SESSION_DURATION_MS - elapsedMs[i]) / 2;
+        }
+    }
+
+    // 먼저 비는 자리 순으로 정렬 (정원은 작으므로 삽입 정렬)
+    for (uint8_t i = 1; i < capacity; i++)
+    {
+        uint32_t value = releaseMs[i];
+        uint8_t j = i;
+        while (j > 0 && releaseMs[j - 1] > value)
+        {
+            releaseMs[j] = releaseMs[j - 1];
+            j--;
+        }
+        releaseMs[j] = value;
+    }
+
+    // position 번째 대기자는 (position-1)/capacity 바퀴 뒤, (position-1)%capacity 번째로 비는 자리에 들어감
+    uint8_t round = (position - 1) / capacity;
+    uint8_t slot = (position - 1) % capacity;
+
+    return releaseMs[slot] + (uint32_t)round * (avgSessionMs + avgAdmissionMs) + avgAdmissionMs;
+}
+
+uint16_t L3_waitModel_toSec(uint32_t ms)
+{
+    uint32_t sec = (ms + 999) / 1000;
+    return (sec >= L3_ETA_UNKNOWN) ? (L3_ETA_UNKNOWN - 1) : (uint16_t)sec;
+}
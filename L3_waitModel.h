@@ -0,0 +1,29 @@
+#ifndef L3_WAITMODEL_H
+#define L3_WAITMODEL_H
+
+#include "mbed.h"
+
+// 부스 대기 시간 모델 (관리자 측)
+//   - 실제 세션 길이 (조기 퇴장 포함) 와 입장 지연 (자리가 빈 뒤 다음 사용자가 들어오기까지) 의 이동 평균
+
+// 모델 초기화 (세션 길이는 최대 세션 시간, 입장 지연은 기본값에서 시작)
+void L3_waitModel_init(void);
+
+// 끝난 세션 길이 반영 (ms)
+void L3_waitModel_addSession(uint32_t durationMs);
+
+// 관측한 입장 지연 반영 (ms)
+void L3_waitModel_addAdmission(uint32_t latencyMs);
+
+// 평균 세션 길이 / 평균 입장 지연 (ms)
+uint32_t L3_waitModel_getSessionMs(void);
+uint32_t L3_waitModel_getAdmissionMs(void);
+
+// position 번째 대기자가 입장하기까지 예상 시간 (ms)
+//   - elapsedMs : 진행 중인 세션들의 경과 시간 (nbActive 개), capacity : 부스 정원
+uint32_t L3_waitModel_estimateMs(uint8_t position, const uint32_t *elapsedMs, uint8_t nbActive, uint8_t capacity);
+
+// ms 를 메시지용 초 단위로 변환 (L3_ETA_UNKNOWN 미만으로 제한)
+uint16_t L3_waitModel_toSec(uint32_t ms);
+
+#endif // L3_WAITMODEL_H
@@ -0,0 +1,224 @@
+#include "mbed.h"
+#include "L3_waitQueue.h"
+#include "protocol_parameters.h"
+
+// 대기열: 티켓 번호로 관리하는 원형 버퍼
+//   - 사용자는 tailTicket 번 티켓(슬롯 = 티켓 % 크기)을 받고, headTicket 이 맨 앞
+//   - 중간 탈퇴는 슬롯을 비워 두기만 하고 (배열 이동/순번 재기록 없음) 양 끝의 빈 슬롯은 바로 정리
+//   - 순번 = head 부터 내 슬롯까지 남아 있는 사용자 수 (슬롯별 Fenwick 트리로 O(log N))
+#define L3_WAITQUEUE_NOSLOT     0xFF
+
+static uint8_t queueUser[L3_WAITQUEUE_SIZE];        // 슬롯별 사용자 ID (0 : 빈 슬롯)
+static uint8_t queueFenwick[L3_WAITQUEUE_SIZE + 1]; // 슬롯별 점유 여부의 누적 합 (1-based)
+static uint8_t slotOfUser[256];                     // 사용자 ID -> 슬롯 (NOSLOT : 대기 중 아님)
+static uint32_t queueSeen[L3_WAITQUEUE_SIZE];       // 슬롯별 마지막으로 소식을 들은 시각 (ms)
+static uint32_t headTicket = 0;
+static uint32_t tailTicket = 0;
+static uint8_t queueCount = 0;
+
+
+static void fenwickAdd(uint8_t slot, int8_t delta)
+{
+    for (uint8_t i = slot + 1; i <= L3_WAITQUEUE_SIZE; i += (i & -i))
+    {
+        queueFenwick[i] += delta;
+    }
+}
+
+// 슬롯 0 ~ slot 에 있는 사용자 수
+static uint8_t fenwickSum(uint8_t slot)
+{
+    uint8_t sum = 0;
+    for (uint8_t i = slot + 1; i > 0; i -= (i & -i))
+    {
+        sum += queueFenwick[i];
+    }
+    return sum;
+}
+
+// 양 끝의 빈 슬롯 정리
+static void trimEnds(void)
+{
+    while (headTicket != tailTicket && queueUser[headTicket % L3_WAITQUEUE_SIZE] == 0)
+    {
+        headTicket++;
+    }
+    while (headTicket != tailTicket && queueUser[(tailTicket - 1) % L3_WAITQUEUE_SIZE] == 0)
+    {
+        tailTicket--;
+    }
+}
+
+static void removeSlot(uint8_t slot)
+{
+    slotOfUser[queueUser[slot]] = L3_WAITQUEUE_NOSLOT;
+    queueUser[slot] = 0;
+    fenwickAdd(slot, -1);
+    queueCount--;
+    trimEnds();
+}
+
+// 중간의 빈 슬롯 때문에 끝까지 찼을 때만 앞으로 당겨 재배치 (드묾)
+static void compact(void)
+{
+    uint8_t users[L3_WAITQUEUE_SIZE];
+    uint32_t seen[L3_WAITQUEUE_SIZE];
+    uint8_t n = 0;
+
+    for (uint32_t t = headTicket; t != tailTicket; t++)
+    {
+        uint8_t userId = queueUser[t % L3_WAITQUEUE_SIZE];
+        if (userId != 0)
+        {
+            seen[n] = queueSeen[t % L3_WAITQUEUE_SIZE];
+            users[n++] = userId;
+        }
+    }
+
+    L3_waitQueue_init();
+    for (uint8_t i = 0; i < n; i++)
+    {
+        L3_waitQueue_push(users[i]);
+        L3_waitQueue_touch(users[i], seen[i]);
+    }
+}
+
+
+void L3_waitQueue_init(void)
+{
+    for (uint8_t i = 0; i < L3_WAITQUEUE_SIZE; i++)
+    {
+        queueUser[i] = 0;
+    }
+    for (uint8_t i = 0; i <= L3_WAITQUEUE_SIZE; i++)
+    {
+        queueFenwick[i] = 0;
+    }
+    for (uint16_t i = 0; i < 256; i++)
+    {
+        slotOfUser[i] = L3_WAITQUEUE_NOSLOT;
+    }
+    headTicket = 0;
+    tailTicket = 0;
+    queueCount = 0;
+}
+
+uint8_t L3_waitQueue_push(uint8_t userId)
+{
+    if (userId == 0 || L3_waitQueue_contains(userId) || queueCount >= L3_WAITQUEUE_SIZE)
+    {
+        return 0;
+    }
+
+    if (tailTicket - headTicket >= L3_WAITQUEUE_SIZE)
+    {
+        compact();
+    }
+
+    uint8_t slot = tailTicket % L3_WAITQUEUE_SIZE;
+    queueUser[slot] = userId;
+    slotOfUser[userId] = slot;
+    fenwickAdd(slot, 1);
+    tailTicket++;
+    queueCount++;
+
+    return 1;
+}
+
+uint8_t L3_waitQueue_pop(void)
+{
+    uint8_t userId = L3_waitQueue_peek();
+    if (userId != 0)
+    {
+        removeSlot(headTicket % L3_WAITQUEUE_SIZE);
+    }
+    return userId;
+}
+
+uint8_t L3_waitQueue_peek(void)
+{
+    if (queueCount == 0)
+    {
+        return 0;
+    }
+    return queueUser[headTicket % L3_WAITQUEUE_SIZE]; // 맨 앞 슬롯은 항상 채워져 있음
+}
+
+uint8_t L3_waitQueue_remove(uint8_t userId)
+{
+    if (!L3_waitQueue_contains(userId))
+    {
+        return 0;
+    }
+
+    removeSlot(slotOfUser[userId]);
+    return 1;
+}
+
+uint8_t L3_waitQueue_contains(uint8_t userId)
+{
+    return slotOfUser[userId] != L3_WAITQUEUE_NOSLOT;
+}
+
+uint8_t L3_waitQueue_getPosition(uint8_t userId)
+{
+    if (!L3_waitQueue_contains(userId))
+    {
+        return 0;
+    }
+
+    uint8_t slot = slotOfUser[userId];
+    uint8_t headSlot = headTicket % L3_WAITQUEUE_SIZE;
+    uint8_t beforeHead = (headSlot > 0) ? fenwickSum(headSlot - 1) : 0;
+
+    if (slot >= headSlot)
+    {
+        return fenwickSum(slot) - beforeHead;
+    }
+
+    // 원형 버퍼가 끝을 넘어간 경우: head ~ 끝 + 처음 ~ slot
+    return (queueCount - beforeHead) + fenwickSum(slot);
+}
+
+uint8_t L3_waitQueue_getCount(void)
+{
+    return queueCount;
+}
+
+uint8_t L3_waitQueue_touch(uint8_t userId, uint32_t timeMs)
+{
+    if (!L3_waitQueue_contains(userId))
+    {
+        return 0;
+    }
+
+    queueSeen[slotOfUser[userId]] = timeMs;
+    return 1;
+}
+
+uint8_t L3_waitQueue_findSilent(uint32_t now, uint32_t silenceMs)
+{
+    for (uint32_t t = headTicket; t != tailTicket; t++)
+    {
+        uint8_t slot = t % L3_WAITQUEUE_SIZE;
+        if (queueUser[slot] != 0 && now - queueSeen[slot] >= silenceMs)
+        {
+            return queueUser[slot];
+        }
+    }
+    return 0;
+}
+
+void L3_waitQueue_forEach(L3_waitQueueFunc_t func)
+{
+    uint8_t position = 0;
+
+    for (uint32_t t = headTicket; t != tailTicket; t++)
+    {
+        uint8_t userId = queueUser[t % L3_WAITQUEUE_SIZE];
+        if (userId != 0)
+        {
+            func(userId, ++position);
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef L3_WAITQUEUE_H
+#define L3_WAITQUEUE_H
+
+#include "mbed.h"
+
+// 대기열 순회 콜백: 사용자 ID, 1부터 시작하는 대기 순번
+typedef void (*L3_waitQueueFunc_t)(uint8_t userId, uint8_t position);
+
+// 대기열 초기화
+void L3_waitQueue_init(void);
+
+// 대기열 끝에 사용자 추가, 성공 시 1 (이미 대기 중이거나 가득 차면 0)
+uint8_t L3_waitQueue_push(uint8_t userId);
+
+// 대기열 맨 앞 사용자를 꺼냄 (비어 있으면 0)
+uint8_t L3_waitQueue_pop(void);
+
+// 대기열 맨 앞 사용자 (비어 있으면 0)
+uint8_t L3_waitQueue_peek(void);
+
+// 대기열 중간에서 사용자 제거 (탈퇴/타임아웃), 제거되면 1
+uint8_t L3_waitQueue_remove(uint8_t userId);
+
+// 대기 중인지 확인 (O(1))
+uint8_t L3_waitQueue_contains(uint8_t userId);
+
+// 1부터 시작하는 현재 대기 순번 (대기 중이 아니면 0)
+uint8_t L3_waitQueue_getPosition(uint8_t userId);
+
+// 대기 인원 수
+uint8_t L3_waitQueue_getCount(void);
+
+// 사용자에게서 메시지를 받은 시각 기록 (대기 중이 아니면 0 반환)
+uint8_t L3_waitQueue_touch(uint8_t userId, uint32_t timeMs);
+
+// now 기준 silenceMs 이상 소식이 없는 맨 앞쪽 사용자 (없으면 0)
+uint8_t L3_waitQueue_findSilent(uint32_t now, uint32_t silenceMs);
+
+// 앞에서부터 대기 사용자 순회
+void L3_waitQueue_forEach(L3_waitQueueFunc_t func);
+
+#endif // L3_WAITQUEUE_H
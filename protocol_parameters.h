@@ -2,8 +2,62 @@
 #define DBGMSG_L3                       0 //debug print control
 
 #define L3_MAXDATASIZE                  1024
+#define L3_DEFERRED_QUEUESIZE           8   //pending deferred sends/calls
+#define L3_DEFERRED_MAXMSGSIZE          32  //max size of a deferred message
+#define L3_WAITQUEUE_SIZE               32  //max users in a booth waiting queue (< 255)
+#define L3_GROUP_HISTORY_SIZE           8   //group frames kept for NACK repair (divides 256)
+#define L3_GROUP_MAXMSGSIZE             110 //max size of a GROUP_DATA message
+#define L3_SCAN_NBSLOTS                 8   //response slots announced in a BOOTH_SCAN
+#define L3_SCAN_SLOTMS                  60  //length of one response slot (ms, multiple of 10)
+#define L3_SCAN_GUARDMS                 200 //extra wait after the last slot (ms)
+#define L3_SCAN_RETRY_MAX               2   //quick re-scans when nobody answered
+#define L3_RETRY_BASEMS                 500 //jitter window added to the first connect/register/scan retry (ms), doubles per attempt
+#define L3_RETRY_CAPMS                  4000 //largest connect/register/scan retry jitter window (ms)
+#define L3_RESCAN_BASEMS                2000 //jitter window before the first periodic re-scan (ms), doubles per empty scan cycle
+#define L3_RESCAN_CAPMS                 16000 //largest periodic re-scan jitter window (ms)
+#define L3_BOOTHTABLE_FRESHMS           10000 //booths heard within this are selected without scanning
+#define L3_BOOTHTABLE_EXPIRYMS          30000 //booths not heard for this long are ignored
+#define L3_BOOTHSCORE_RSSIALPHA         2   //RSSI moving average weight of a new sample : 1/2^N
+#define L3_BOOTHSCORE_RSSIWEIGHT        1   //score points per dB of averaged RSSI
+#define L3_BOOTHSCORE_FREEBONUS         20  //score bonus when the booth has a free slot
+#define L3_BOOTHSCORE_WAITPENALTY       1   //score penalty per 10 s of predicted wait
+#define L3_BOOTHSCORE_HYSTERESIS        6   //margin a booth needs to replace the previous choice
+#define L3_BOOTHSCORE_SESSIONMS         SESSION_DURATION_MS //typical session length for wait prediction (no ETA from the booth)
+#define L3_WAITMODEL_ALPHA              3   //session/admission moving average weight of a new sample : 1/2^N
+#define L3_WAITMODEL_ADMISSIONMS        3000 //initial admission latency estimate (ms)
+#define L3_PRESENCE_RSSI                -65 //averaged RSSI (dBm) at which a called user counts as near the booth
+#define L3_PRESENCE_FARWAITMS           4000 //how long the booth keeps calling a user who answered "not near yet" (ms)
+#define L3_PRESENCE_PROBEMS             1000 //QUEUE_READY re-send period while a called user is not near (ms)
+#define L3_KEEPALIVE_PERIODMS           10000 //KEEPALIVE period of a user inside or queued at a booth (ms)
+#define L3_PRESENCE_SILENCEMS           35000 //booth releases active/waiting users silent for this long (ms, 0 : never)
+#define L3_ANNOUNCE_IMINMS              1000 //BOOTH_ANNOUNCE interval right after the occupancy or queue length changed (ms)
+#define L3_ANNOUNCE_IMAXMS              32000 //BOOTH_ANNOUNCE interval doubles up to this while the booth state is stable (ms)
+#define L3_ANNOUNCE_K                   1   //BOOTH_ANNOUNCE is skipped in an interval where this many identical announces already went out
+#define L3_RESPCACHE_SIZE               8   //admin responses kept for answering retried requests (one per user and request type)
+#define L3_RESPCACHE_MSGSIZE            60  //largest cached response (BOOTH_INFO with full description)
+#define L3_RESPCACHE_MS                 10000 //a retried request is answered from the cache within this time (ms)
+#define L3_ADMISSION_SCAN_PERIODMS      100 //admin answers one BOOTH_SCAN per this period on average (ms, 0 : no limit)
+#define L3_ADMISSION_SCAN_BURST         8   //BOOTH_SCANs answered back to back before the limit applies
+#define L3_ADMISSION_CONNECT_PERIODMS   300 //admin answers one CONNECT_REQUEST per this period on average (ms, 0 : no limit)
+#define L3_ADMISSION_CONNECT_BURST      4   //CONNECT_REQUESTs answered back to back before the limit applies
+#define L3_ADMISSION_JOIN_PERIODMS      500 //admin decides one REGISTER/JOIN_REQUEST per this period on average (ms, 0 : no limit)
+#define L3_ADMISSION_JOIN_BURST         3   //REGISTER/JOIN_REQUESTs decided back to back before the limit applies
+#define L3_ADMISSION_PENDING_SIZE       8   //REGISTER/JOIN_REQUESTs held by the admin until a token is available
+#define L3_ADMISSION_MARGINMS           1000 //extra time a user with a held request waits before re-sending it (ms)
+#define L3_ADMISSION_MAXRETRYMS         10000 //largest retry-after in a BUSY response (ms)
+#define L3_CHAT_COMPRESS                1   //send chat as CHAT_COMPACT (static dictionary) when that is shorter than the raw text
+#define L3_TICKET_MAX                   2   //extra booth queues a user joins besides its current one in virtual-ticket mode
+#define L3_FED_GAINSEC                  30  //another booth must admit a waiting user this much sooner to offer a transfer (s, 0 : no offers)
+#define L3_FED_MAXAGEMS                 40000 //another booth's status is used for offers only if announced this recently (ms, above L3_ANNOUNCE_IMAXMS)
+#define L3_FED_OFFERMS                  5000 //minimum period between two transfer offers of a booth (ms)
 
 
 #define L2_ARQ_MAXRETRANSMISSION        10
 #define L2_ARQ_MAXWAITTIME              3   // 5 -> 3더 빠른 재전송
-#define L2_ARQ_MINWAITTIME              1  // 2->1 감소
\ No newline at end of file
+#define L2_ARQ_MINWAITTIME              1  // 2->1 감소
+#define L2_ARQ_BACKOFFBASEMS            250 //ARQ timeout jitter window after the first transmission (ms), doubles per retransmission up to the max wait
+#define L2_TXQUEUE_SIZE                 16  //pending DATA_REQ SDUs, holds the largest L3 burst (group repair of the whole history + announce + queue snapshot)
+#define L2_TXQUEUE_MAXSDUSIZE           200 //max SDU size accepted by DATA_REQ
+
+#define L2_FSM_PROFILING                1   //per-transition counters and dispatch latency
+#define L2_FSM_STATPERIOD               0   //print transition stats every N dispatches (0 : never)